@@ -0,0 +1,106 @@
+/**
+   \file bucketopenlist.cpp
+   \brief Plans the same queries with the bucket open list and with the exact heap, and reports the length of the
+   paths, the number of nodes and the time per plan of each
+*/
+
+#include <ros/ros.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "scene.h"
+
+using namespace HybridAStar;
+
+namespace
+{
+/// A query of the benchmark in cells
+struct Query
+{
+    float sx, sy, st, gx, gy, gt;
+};
+
+/// The result of a query
+struct Result
+{
+    /// the length of the path or -1 if none reaching the goal was found
+    float length;
+    /// the number of stored nodes
+    int nodes;
+    /// the time per plan in ms
+    double time;
+};
+
+/// The number of times a query is planned per open list
+const int repetitions = 10;
+
+/// Plans the query repeatedly on the scene
+Result plan(Scene& scene, const Query& query)
+{
+    int  solution = -1;
+    auto start    = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < repetitions; ++i)
+    {
+        solution = scene.plan(query.sx, query.sy, query.st, query.gx, query.gy, query.gt);
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return Result{scene.pathLength(solution), scene.nodes(), elapsed.count() / repetitions};
+}
+}  // namespace
+
+//###################################################
+//                                               MAIN
+//###################################################
+int main(int argc, char** argv)
+{
+    ros::init(argc, argv, "bench_bucketopenlist");
+
+    Scene heapScene("map.pgm");
+    Scene bucketScene("map.pgm");
+    heapScene.workspace.bucketOpenList   = false;
+    bucketScene.workspace.bucketOpenList = true;
+
+    const std::vector<Query> queries = {{20, 205, 0, 280, 205, 0},
+                                        {20, 40, 0, 120, 150, M_PI / 2},
+                                        {150, 40, M_PI, 40, 200, M_PI / 2},
+                                        {150, 205, 0, 140, 205, 0},
+                                        {280, 30, M_PI / 2, 280, 300, M_PI / 2}};
+
+    std::cout << "bucket width " << Constants::bucketWidth << ", ties broken by "
+              << (Constants::bucketTieBreakH ? "the lowest H" : "last in first out") << std::endl;
+    std::cout << std::setw(6) << "query" << std::setw(12) << "heap len" << std::setw(12) << "bucket len"
+              << std::setw(10) << "ratio" << std::setw(12) << "heap nodes" << std::setw(14) << "bucket nodes"
+              << std::setw(10) << "heap ms" << std::setw(12) << "bucket ms" << std::setw(10) << "speedup" << std::endl;
+
+    double heapTime = 0, bucketTime = 0;
+
+    for (size_t q = 0; q < queries.size(); ++q)
+    {
+        Result heap   = plan(heapScene, queries[q]);
+        Result bucket = plan(bucketScene, queries[q]);
+        heapTime += heap.time;
+        bucketTime += bucket.time;
+
+        std::cout << std::setw(6) << q << std::fixed << std::setprecision(2) << std::setw(12) << heap.length
+                  << std::setw(12) << bucket.length << std::setprecision(3) << std::setw(10)
+                  << bucket.length / heap.length << std::setw(12) << heap.nodes << std::setw(14) << bucket.nodes
+                  << std::setprecision(2) << std::setw(10) << heap.time << std::setw(12) << bucket.time
+                  << std::setw(10) << heap.time / bucket.time << std::endl;
+
+        // the quantization may cost so many expansions that the limit of iterations is reached first
+        if (heap.length < 0 || bucket.length < 0)
+        {
+            std::cout << std::setw(6) << q << " did not reach the goal within " << Constants::iterations
+                      << " iterations with the " << (heap.length < 0 ? "heap" : "buckets") << std::endl;
+        }
+    }
+
+    std::cout << "total " << std::fixed << std::setprecision(2) << heapTime << " ms with the heap, " << bucketTime
+              << " ms with the buckets" << std::endl;
+    return 0;
+}
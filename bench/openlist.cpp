@@ -0,0 +1,208 @@
+/**
+   \file openlist.cpp
+   \brief Replays the open list operations of recorded searches through IndexedHeap and the boost binomial heap it
+   replaced, and reports the time per operation of each
+*/
+
+#include <ros/ros.h>
+
+#include <boost/heap/binomial_heap.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "scene.h"
+
+using namespace HybridAStar;
+
+namespace
+{
+/// A query of the benchmark in cells
+struct Query
+{
+    float sx, sy, st, gx, gy, gt;
+};
+
+/// The number of times a trace is replayed per open list
+const int replays = 20;
+
+//###################################################
+//                                       INDEXED HEAP
+//###################################################
+/// Replays the trace through an IndexedHeap, it returns the number of pops that did not match the trace
+int replayIndexedHeap(const OpenListTrace& trace, IndexedHeap& heap)
+{
+    int mismatches = 0;
+    heap.clear();
+
+    for (const OpenListTrace::Event& event : trace.events)
+    {
+        if (event.operation == OpenListTrace::push)
+        {
+            heap.push(event.id, event.key);
+        }
+        else
+        {
+            mismatches += heap.topKey() != event.key;
+            heap.pop();
+        }
+    }
+
+    return mismatches;
+}
+
+//###################################################
+//                                BOOST BINOMIAL HEAP
+//###################################################
+/// An entry of the boost heap, duplicated on decrease-key
+struct Entry
+{
+    float key;
+    int   id;
+};
+
+/// Orders the entries of the boost heap by the lowest key
+struct CompareEntries
+{
+    bool operator()(const Entry& lhs, const Entry& rhs) const
+    {
+        return lhs.key > rhs.key;
+    }
+};
+
+/// The open list before IndexedHeap, a decrease-key pushes a duplicate and pops skip the stale entries
+typedef boost::heap::binomial_heap<Entry, boost::heap::compare<CompareEntries>> BinomialHeap;
+
+/// Replays the trace through the boost heap, it returns the number of pops that did not match the trace
+int replayBinomialHeap(const OpenListTrace& trace, std::vector<float>& key, std::vector<char>& open)
+{
+    int          mismatches = 0;
+    BinomialHeap heap;
+
+    for (const OpenListTrace::Event& event : trace.events)
+    {
+        if (event.operation == OpenListTrace::push)
+        {
+            heap.push(Entry{event.key, event.id});
+            key[event.id]  = event.key;
+            open[event.id] = true;
+        }
+        else
+        {
+            // skip the entries of ids popped before or pushed again with a lower key
+            while (!open[heap.top().id] || heap.top().key != key[heap.top().id])
+            {
+                heap.pop();
+            }
+
+            Entry top = heap.top();
+            heap.pop();
+            mismatches += top.key != event.key;
+
+            // a tie broken differently than by the search is resolved in its favor, so that both keep the same ids
+            if (top.id != event.id)
+            {
+                heap.push(top);
+            }
+
+            open[event.id] = false;
+        }
+    }
+
+    return mismatches;
+}
+
+/// get the time in ns per operation of the trace replayed by the function
+template <typename Replay>
+double timePerOperation(const OpenListTrace& trace, Replay replay, int& mismatches)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < replays; ++i)
+    {
+        mismatches = replay();
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / replays / trace.events.size();
+}
+}  // namespace
+
+//###################################################
+//                                               MAIN
+//###################################################
+int main(int argc, char** argv)
+{
+    ros::init(argc, argv, "bench_openlist");
+
+    Scene                    scene("map.pgm");
+    const std::vector<Query> queries = {{20, 205, 0, 280, 205, 0},
+                                        {20, 40, 0, 120, 150, M_PI / 2},
+                                        {150, 40, M_PI, 40, 200, M_PI / 2},
+                                        {150, 205, 0, 140, 205, 0},
+                                        {280, 30, M_PI / 2, 280, 300, M_PI / 2}};
+
+    std::cout << std::setw(8) << "query" << std::setw(10) << "pushes" << std::setw(10) << "decrease" << std::setw(10)
+              << "pops" << std::setw(14) << "indexed ns" << std::setw(14) << "binomial ns" << std::setw(10)
+              << "speedup" << std::endl;
+
+    for (size_t q = 0; q < queries.size(); ++q)
+    {
+        const Query&  query = queries[q];
+        OpenListTrace trace;
+        scene.plan(query.sx, query.sy, query.st, query.gx, query.gy, query.gt, &trace);
+
+        // classify the pushes of ids that are contained as decrease-keys
+        int               pushes = 0, decreases = 0, pops = 0, ids = 0;
+        std::vector<char> contained;
+
+        for (const OpenListTrace::Event& event : trace.events)
+        {
+            if (event.id >= ids)
+            {
+                ids = event.id + 1;
+                contained.resize(ids, false);
+            }
+
+            if (event.operation == OpenListTrace::pop)
+            {
+                pops++;
+                contained[event.id] = false;
+            }
+            else if (contained[event.id])
+            {
+                decreases++;
+            }
+            else
+            {
+                pushes++;
+                contained[event.id] = true;
+            }
+        }
+
+        IndexedHeap        heap;
+        std::vector<float> key(ids);
+        std::vector<char>  open(ids);
+        int                indexedMismatches = 0, binomialMismatches = 0;
+        heap.reserve(ids);
+
+        double indexed  = timePerOperation(trace, [&]() { return replayIndexedHeap(trace, heap); }, indexedMismatches);
+        double binomial = timePerOperation(trace, [&]() { return replayBinomialHeap(trace, key, open); },
+                                           binomialMismatches);
+
+        std::cout << std::setw(8) << q << std::setw(10) << pushes << std::setw(10) << decreases << std::setw(10) << pops
+                  << std::fixed << std::setprecision(1) << std::setw(14) << indexed << std::setw(14) << binomial
+                  << std::setprecision(2) << std::setw(10) << binomial / indexed << std::endl;
+
+        // both open lists pop the same keys in the same order, ties may be broken differently
+        if (indexedMismatches != 0 || binomialMismatches != 0)
+        {
+            std::cout << "the replay of query " << q << " popped different keys than the search, indexed "
+                      << indexedMismatches << " binomial " << binomialMismatches << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
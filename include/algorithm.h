@@ -1,16 +1,12 @@
 #ifndef ALGORITHM_H
 #define ALGORITHM_H
 
-#include <ompl/base/State.h>
-#include <ompl/base/spaces/DubinsStateSpace.h>
-#include <ompl/base/spaces/ReedsSheppStateSpace.h>
-#include <ompl/base/spaces/SE2StateSpace.h>
-
-typedef ompl::base::SE2StateSpace::StateType State;
-
 #include "collisiondetection.h"
+#include "holonomicheuristic.h"
 #include "node2d.h"
 #include "node3d.h"
+#include "searchworkspace.h"
+#include "tracingheap.h"
 #include "visualize.h"
 
 namespace HybridAStar
@@ -36,18 +32,23 @@ public:
 
        \param start the start pose
        \param goal the goal pose
-       \param nodes3D the array of 3D nodes representing the configuration space C in R^3
-       \param nodes2D the array of 2D nodes representing the configuration space C in R^2
+       \param workspace the sparse store of 3D nodes representing the configuration space C in R^3 and the open list
+       \param holonomic the cost-to-goal field of the holonomic with obstacles heuristic
        \param width the width of the grid in number of cells
        \param height the height of the grid in number of cells
-       \param configurationSpace the lookup of configurations and their spatial occupancy enumeration
-       \param dubinsLookup the lookup of analytical solutions (Dubin's paths)
+       \param configurationSpace the lookup of configurations and their spatial occupancy enumeration, updated for the
+       headings and the motion primitives of the configuration
+       \param dubinsLookup the lookup of analytical solutions (Dubin's paths) or a nullptr while it is not available
+       \param config the configuration of the planner, the motion primitives in particular
        \param visualization the visualization object publishing the search to RViz
-       \return the pointer to the node satisfying the goal condition
+       \param trace if not a nullptr the search runs on the exact heap and records its operations on it
+       \return the position of the node satisfying the goal condition in workspace.nodes3D or -1, its path is traced
+       through the positions of the predecessors
     */
-    static Node3D* hybridAStar(Node3D& start, const Node3D& goal, Node3D* nodes3D, Node2D* nodes2D, int width,
-                               int height, CollisionDetection& configurationSpace, float* dubinsLookup,
-                               Visualize& visualization);
+    static int hybridAStar(Node3D& start, const Node3D& goal, SearchWorkspace& workspace,
+                           const HolonomicHeuristic& holonomic, int width, int height,
+                           CollisionDetection& configurationSpace, const float* dubinsLookup,
+                           const PlannerConfig& config, Visualize& visualization, OpenListTrace* trace = nullptr);
 
     // static int                succ_size_;
     // static int                forward_size_;
@@ -0,0 +1,229 @@
+#ifndef BUCKETOPENLIST_H
+#define BUCKETOPENLIST_H
+
+#include <vector>
+
+#include "constants.h"
+
+namespace HybridAStar
+{
+/*!
+   \brief An open list of ids whose keys are quantized into buckets of a fixed width, an alternative to IndexedHeap.
+
+   The key of an id determines its bucket, pushing and changing the key of an id are O(1). Popping advances a cursor to
+   the lowest non-empty bucket, which is cheap as the costs of the search grow in small steps. The cursor moves back if
+   a key below it is pushed, so the heuristic does not need to be consistent.
+
+   Within a bucket the ids are ordered by a tie breaking rule, either the lowest tie value first (e.g. H, preferring
+   nodes closer to the goal), or last in first out. The slot of the lowest tie value is cached per bucket, pushes keep
+   it up to date and only removing it makes the next top() scan the bucket again. Keys beyond the last bucket, e.g. of
+   nodes that can not reach the goal, share the last bucket.
+*/
+class BucketOpenList
+{
+public:
+    /*!
+       \brief Constructs an empty open list
+       \param width the width of a bucket in units of the key
+       \param lowestTie whether to break ties by the lowest tie value (true) or last in first out (false)
+    */
+    BucketOpenList(float width = Constants::bucketWidth, bool lowestTie = Constants::bucketTieBreakH)
+        : width(width), lowestTie(lowestTie), cursor(0), highest(-1), count(0)
+    {
+    }
+
+    /// Removes all entries, in proportion to the number of buckets used
+    void clear()
+    {
+        for (int b = 0; b <= highest; ++b)
+        {
+            for (const Entry& entry : buckets[b])
+            {
+                position[entry.id].bucket = -1;
+            }
+
+            buckets[b].clear();
+            bestSlot[b] = -1;
+        }
+
+        cursor  = 0;
+        highest = -1;
+        count   = 0;
+    }
+
+    /// Determines whether the open list is empty
+    bool empty() const
+    {
+        return count == 0;
+    }
+    /// get the number of entries
+    int size() const
+    {
+        return count;
+    }
+    /// Determines whether the id is contained
+    bool contains(int id) const
+    {
+        return id < (int)position.size() && position[id].bucket >= 0;
+    }
+
+    /// get the id to be expanded next, the open list must not be empty
+    int top()
+    {
+        return buckets[cursor][best()].id;
+    }
+    /// Removes the id to be expanded next
+    void pop()
+    {
+        removeAt(cursor, best());
+    }
+
+    /*!
+       \brief Inserts the id or moves it to the bucket of its new key if it is already contained
+       \param id the id
+       \param key the key determining the bucket
+       \param tie the value breaking ties within the bucket
+    */
+    void push(int id, float key, float tie)
+    {
+        if (id >= (int)position.size())
+        {
+            position.resize(id + 1, Position{-1, 0});
+        }
+
+        if (position[id].bucket >= 0)
+        {
+            removeAt(position[id].bucket, position[id].slot);
+        }
+
+        // keys beyond the last bucket, including infinity, are clamped
+        int b = key < 0 ? 0 : key / width < maxBuckets - 1 ? (int)(key / width) : maxBuckets - 1;
+
+        if (b >= (int)buckets.size())
+        {
+            buckets.resize(b + 1);
+            bestSlot.resize(b + 1, -1);
+        }
+
+        std::vector<Entry>& bucket = buckets[b];
+        int                 slot   = bucket.size();
+
+        // the last of the lowest tie values is expanded first, a new entry replaces a known best one it does not exceed
+        if (slot == 0 || (bestSlot[b] >= 0 && tie <= bucket[bestSlot[b]].tie))
+        {
+            bestSlot[b] = slot;
+        }
+
+        position[id] = Position{b, slot};
+        bucket.push_back(Entry{id, tie});
+        count++;
+
+        if (b < cursor)
+        {
+            cursor = b;
+        }
+
+        if (b > highest)
+        {
+            highest = b;
+        }
+    }
+
+private:
+    /// An entry of a bucket
+    struct Entry
+    {
+        /// the id
+        int id;
+        /// the value breaking ties within the bucket
+        float tie;
+    };
+
+    /// The location of an id
+    struct Position
+    {
+        /// the bucket or -1 if the id is not contained
+        int bucket;
+        /// the index within the bucket
+        int slot;
+    };
+
+    /// The number of buckets, keys beyond are clamped to the last one
+    static const int maxBuckets = 1 << 16;
+
+    /// Advances the cursor to the lowest non-empty bucket and returns the slot to be expanded next, cached for pop()
+    int best()
+    {
+        while (buckets[cursor].empty())
+        {
+            cursor++;
+        }
+
+        const std::vector<Entry>& bucket = buckets[cursor];
+
+        if (!lowestTie)
+        {
+            return bucket.size() - 1;
+        }
+
+        int& slot = bestSlot[cursor];
+
+        // scan the bucket only if the cached slot was removed
+        if (slot < 0)
+        {
+            slot = bucket.size() - 1;
+
+            for (int i = slot - 1; i >= 0; --i)
+            {
+                if (bucket[i].tie < bucket[slot].tie)
+                {
+                    slot = i;
+                }
+            }
+        }
+
+        return slot;
+    }
+
+    /// Removes the entry at the slot of the bucket by moving the last entry of the bucket into its place
+    void removeAt(int b, int slot)
+    {
+        std::vector<Entry>& bucket       = buckets[b];
+        int                 last         = bucket.size() - 1;
+        position[bucket[slot].id].bucket = -1;
+
+        // the best entry is removed or moved ahead of entries with the same tie value, which are expanded first then
+        if (bestSlot[b] == slot || bestSlot[b] == last)
+        {
+            bestSlot[b] = -1;
+        }
+
+        if (slot < last)
+        {
+            bucket[slot]                   = bucket.back();
+            position[bucket[slot].id].slot = slot;
+        }
+
+        bucket.pop_back();
+        count--;
+    }
+
+    /// the width of a bucket
+    float width;
+    /// whether ties are broken by the lowest tie value, else last in first out
+    bool lowestTie;
+    /// the buckets
+    std::vector<std::vector<Entry>> buckets;
+    /// the slot of every bucket to be expanded next or -1 if it has to be found by a scan
+    std::vector<int> bestSlot;
+    /// the location of every id
+    std::vector<Position> position;
+    /// a lower bound of the lowest non-empty bucket
+    int cursor;
+    /// the highest bucket used since the last clear
+    int highest;
+    /// the number of entries
+    int count;
+};
+}  // namespace HybridAStar
+#endif  // BUCKETOPENLIST_H
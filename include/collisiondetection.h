@@ -3,8 +3,13 @@
 
 #include <nav_msgs/OccupancyGrid.h>
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "constants.h"
-#include "lookup.h"
+#include "dynamicvoronoi.h"
+#include "footprinttable.h"
 #include "node2d.h"
 #include "node3d.h"
 
@@ -32,13 +37,50 @@ inline void getConfiguration(const Node3D* node, float& x, float& y, float& t)
    collision with the environment.
 
    It is supposed to return a boolean value that returns true for collisions and false in the case of a safe node.
+
+   The occupancy of the grid is kept as a bitmap with one bit per cell, every row padded by a free word on both sides.
+   The footprint of every configuration is taken from the shared FootprintTable as one 64 bit mask per row it covers,
+   so a configuration is tested by a single AND of each mask with the bits of the row at the footprint. Cells off the
+   grid are free.
+
+   Before that the cell of the configuration is classified by its distance to the closest obstacle. Far from any
+   obstacle every heading is free, within the inscribed circle of the vehicle every heading collides, only in the band
+   between the footprint is tested.
+
+   The edge between a configuration and its successor by a motion primitive is tested by the swept footprint of the
+   primitive, the cells covered by the vehicle between the two, built whenever the primitives change.
+
+   The grid is further summarized in tiles of 8 x 8 cells that are either empty, full or mixed. A footprint whose
+   bounding box covers only empty tiles is free, else only the rows of the footprint reaching into tiles that are not
+   empty are tested against the bitmap.
+
+   Alternatively the vehicle is covered by Constants::diskCount disks along its length, a configuration is free if the
+   distance to the closest obstacle at the center of every disk exceeds its radius. The test takes as many lookups as
+   there are disks regardless of the size of the vehicle, but it is more conservative than the footprint. The search,
+   the analytical expansion and the smoother all test configurations through isTraversable, the model is selected by
+   setModel.
 */
 class CollisionDetection
 {
 public:
+    /// The collision models
+    enum Model
+    {
+        /// the rasterized footprint of the collision lookup
+        footprint,
+        /// the disks covering the vehicle
+        disks
+    };
+
     /// Constructor
     CollisionDetection();
 
+    /// Selects the collision model used by isTraversable
+    void setModel(Model model)
+    {
+        this->model = model;
+    }
+
     /*!
        \brief evaluates whether the configuration is safe
        \return true if it is traversable, else false
@@ -63,7 +105,11 @@ public:
             return !grid->data[node->getIdx()];
         }
 
-        if (true)
+        if (model == disks)
+        {
+            cost = diskTest(x, y, t) ? 0 : 1;
+        }
+        else if (true)
         {
             cost = configurationTest(x, y, t) ? 0 : 1;
         }
@@ -97,19 +143,136 @@ public:
     */
     bool configurationTest(float x, float y, float t) const;
 
+    /// The maximum number of poses of a batch
+    static const int batchSize = 32;
+
+    /*!
+       \brief Tests whether all configurations of a batch are in C_free by the collision model of isTraversable
+
+       The cells of all poses are classified by their distance to the closest obstacle first, so that a pose close to an
+       obstacle rejects the batch before the footprint of any pose is tested.
+       \param x the x positions
+       \param y the y positions
+       \param t the theta angles
+       \param n the number of poses, at most batchSize
+       \return true if every configuration is in C_free, else false
+    */
+    bool batchTest(const float* x, const float* y, const float* t, int n) const;
+
     /*!
-       \brief updates the grid with the world map
+       \brief Tests whether the robot stays in C_free between the configuration q and the end of the motion primitive
+       \param x the x position
+       \param y the y position
+       \param t the theta angle
+       \param prim the motion primitive
+       \return true if the swept footprint of the primitive is in C_free, else false
     */
-    void updateGrid(nav_msgs::OccupancyGrid::Ptr map)
+    bool sweepTest(float x, float y, float t, int prim) const;
+
+    /// evaluates whether the edge from the node by the motion primitive is safe, not testing its end
+    bool isSweepTraversable(const Node3D& node, int prim) const
     {
-        grid = map;
+        return sweepTest(node.getX(), node.getY(), node.getT(), prim);
     }
 
+    /*!
+       \brief Tests whether the configuration q of the robot is in C_free by the disks covering the vehicle, if a disk
+       is not covered by the distances of the grid the footprint is tested instead
+       \param x the x position
+       \param y the y position
+       \param t the theta angle
+       \return true if it is in C_free, else false
+    */
+    bool diskTest(float x, float y, float t) const;
+
+    /*!
+       \brief updates the grid with the world map and builds its occupancy bitmap
+    */
+    void updateGrid(nav_msgs::OccupancyGrid::Ptr map);
+
+    /*!
+       \brief selects the footprints for the number of headings, rebuilding the swept footprints if it changed
+       \param headings the number of headings
+    */
+    void updateHeadings(int headings);
+
+    /*!
+       \brief builds the swept footprints of the motion primitives if they changed
+       \param dx the displacement of every primitive along the heading of its start
+       \param dy the displacement of every primitive perpendicular to the heading of its start
+       \param dt the change of heading of every primitive
+    */
+    void updatePrimitives(const std::vector<float>& dx, const std::vector<float>& dy, const std::vector<float>& dt);
+
+    /*!
+       \brief classifies the cells of the grid by their distance to the closest obstacle
+       \param voronoi the Voronoi diagram of the current grid holding the distance to the closest obstacle
+    */
+    void updateDistances(const DynamicVoronoi& voronoi);
+
 private:
+    /// Tests the footprint of the configuration of the table placed at the cell against the occupancy of the grid
+    bool footprintTest(const FootprintTable& table, int idx, int X, int Y) const;
+
+    /// The classes of tiles by their occupancy
+    enum Tile : uint8_t
+    {
+        /// no cell of the tile is occupied
+        empty,
+        /// every cell of the tile is occupied
+        full,
+        /// some cells of the tile are occupied
+        mixed
+    };
+
+    /// The edge length of a tile in cells, a row of a tile is a byte of the bitmap
+    static const int tileSize = 8;
+
+    /// The classes of cells by their distance to the closest obstacle
+    enum Clearance : uint8_t
+    {
+        /// every configuration of the cell collides
+        blocked,
+        /// the footprint of the configuration has to be tested
+        band,
+        /// every configuration of the cell is free
+        clear
+    };
+
     /// The occupancy grid
     nav_msgs::OccupancyGrid::Ptr grid;
-    /// The collision lookup table
-    Constants::config collisionLookup[Constants::headings * Constants::positions];
+    /// The width of the grid
+    int width = 0;
+    /// The height of the grid
+    int height = 0;
+    /// The number of words of a row of the bitmap, including the padding
+    int stride = 0;
+    /// The occupancy bitmap, bit x + 64 of a row is the cell x
+    std::vector<uint64_t> occupancy;
+    /// The number of tiles of a row of tiles
+    int tilesWide = 0;
+    /// The class of every tile, the tile (tX, tY) covers the cells from (tX, tY) * tileSize
+    std::vector<Tile> tiles;
+    /// The footprints of all configurations, shared by all collision detections
+    std::shared_ptr<const FootprintTable> footprints;
+    /// The swept footprints of the motion primitives for all configurations, empty until the primitives are known
+    std::shared_ptr<const FootprintTable> sweeps;
+    /// The number of motion primitives
+    int primitives = 0;
+    /// The displacements along the heading the swept footprints were built for
+    std::vector<float> sweepDx;
+    /// The displacements perpendicular to the heading the swept footprints were built for
+    std::vector<float> sweepDy;
+    /// The changes of heading the swept footprints were built for
+    std::vector<float> sweepDt;
+    /// The class of every cell by its distance to the closest obstacle, empty until the distances of the grid are known
+    std::vector<Clearance> clearance;
+    /// The distance of every cell to the closest obstacle in cells, empty until the distances of the grid are known
+    std::vector<float> distance;
+    /// The offsets of the centers of the disks along the heading in cells
+    float diskOffset[Constants::diskCount];
+    /// The collision model
+    Model model = Constants::collisionDisks ? disks : footprint;
 };
 }  // namespace HybridAStar
 #endif  // COLLISIONDETECTION_H
@@ -14,6 +14,7 @@
 //    Y-COORDINATE => designating the height of the grid
 
 #include <cmath>
+#include <cstdint>
 
 /*!
     \brief The namespace that wraps the entire project
@@ -41,18 +42,28 @@ static const bool visualization = true && manual;
 static const bool visualization2D = false && manual;
 /// A flag to toggle reversing (true = on; false = off)
 static const bool reverse = true;
-/// A flag to toggle the connection of the path via Dubin's shot (true = on; false = off)
+/// A flag to toggle the analytical shot to the goal, Reeds-Shepp if reversing else Dubin's (true = on; false = off)
 static const bool dubinsShot = true;
 /// A flag to toggle the Dubin's heuristic, this should be false, if reversing is enabled (true = on; false = off)
 static const bool dubins = false;
 /*!
    \var static const bool dubinsLookup
-   \brief A flag to toggle the Dubin's heuristic via lookup, potentially speeding up the search by a lot
-   \todo not yet functional
+   \brief A flag to toggle the Dubin's or Reeds-Shepp heuristic via lookup, potentially speeding up the search by a lot
+
+   The lookup holds a lower bound of the length of the analytical solution for the relative pose of the goal near the
+   start, outside of it the length is computed analytically.
 */
-static const bool dubinsLookup = false && dubins;
+static const bool dubinsLookup = true;
+/// The file caching the lookups across restarts, it is rebuilt if it does not match the constants
+static const char* const lookupCache = "/tmp/hybrid_astar_lookups.bin";
 /// A flag to toggle the 2D heuristic (true = on; false = off)
 static const bool twoD = true;
+/// A flag to toggle the early accept and reject of configurations by their distance to the closest obstacle
+static const bool collisionDistance = true;
+/// A flag to toggle the test of the swept footprint of a motion primitive between its start and its end
+static const bool collisionSweep = true;
+/// A flag for the collision model (true = disks covering the vehicle; false = rasterized footprint of the lookup)
+static const bool collisionDisks = false;
 
 // _________________
 // GENERAL CONSTANTS
@@ -67,7 +78,7 @@ static const double width = 1.75 + 2 * bloating;
 static const double length = 2.65 + 2 * bloating;
 /// [m] --- The minimum turning radius of the vehicle
 static const float r = 6;
-/// [m] --- The number of discretizations in heading
+/// [#] --- The number of discretizations in heading of the analytical lookup and the default of the planner
 static const int headings = 72;
 /// [°] --- The discretization value of the heading (goal condition)
 static const float deltaHeadingDeg = 360 / (float)headings;
@@ -77,6 +88,8 @@ static const float deltaHeadingRad = 2 * M_PI / (float)headings;
 static const float deltaHeadingNegRad = 2 * M_PI - deltaHeadingRad;
 /// [m] --- The cell size of the 2D grid of the world
 static const float cellSize = 1;
+/// [#] --- The length in cells of one unit of the step sizes of the motion primitives in param.yaml (6.75° in rad)
+static const double primitiveStepUnit = 0.1178097;
 /*!
   \brief [m] --- The tie breaker breaks ties between nodes expanded in the same cell
 
@@ -104,6 +117,21 @@ static const float dubinsShotDistance = 100;
 /// [m] --- The step size for the analytical solution (Dubin's shot) primarily relevant for collision checking
 static const float dubinsStepSize = 1;
 
+// _____________________
+// OPEN LIST SPECIFIC
+
+/// A flag to toggle the quantized bucket open list of the 3D search instead of the exact heap (true = on; false = off)
+static const bool bucketOpenList = false;
+/*!
+  \brief [#] --- The width of a bucket of the bucket open list in units of the cost
+
+  Nodes whose C values fall into the same bucket are considered equal and ordered by the tie breaking rule, a larger
+  width trades solution quality for cheaper operations.
+*/
+static const float bucketWidth = 0.25;
+/// A flag for the tie breaking rule within a bucket (true = lowest H first; false = last in first out)
+static const bool bucketTieBreakH = true;
+
 // ______________________
 // DUBINS LOOKUP SPECIFIC
 
@@ -121,25 +149,40 @@ static const int bbSize = std::ceil((sqrt(width * width + length * length) + 4)
 static const int positionResolution = 10;
 /// [#] --- The number of discrete positions per cell
 static const int positions = positionResolution * positionResolution;
+/*!
+   \var static const float collisionAcceptDistance
+   \brief [#] --- The distance of a cell to the closest obstacle in cells beyond which every configuration is free
+
+   The radius of the circle circumscribing the vehicle, plus the diagonal of a cell for the position within the cell and
+   the diagonal of a cell for the cells the rasterization of the footprint adds at its boundary.
+*/
+static const float collisionAcceptDistance = sqrt(width * width + length * length) / 2 / cellSize + 2 * M_SQRT2;
+/// [#] --- The distance of a cell to the closest obstacle in cells below which every configuration collides
+static const float collisionRejectDistance = width / 2 / cellSize;
+/// [#] --- The largest distance a cell of the footprint moves between the poses sampled along a motion primitive
+static const float sweepResolution = 0.1;
+/// [#] --- The number of disks along the length of the vehicle covering it in the disk collision model
+static const int diskCount = 3;
+/// [#] --- The radius of the disks in cells, each covers a section of length / diskCount of the vehicle
+static const float diskRadius = sqrt(length * length / (4 * diskCount * diskCount) + width * width / 4) / cellSize;
+/// [#] --- The number of discrete relative positions of the lookup per axis and side (Dubin's lookup)
+static const int dubinsLookupSteps = dubinsWidth / cellSize * positionResolution;
+/*!
+   \var static const int dubinsLookupSize
+   \brief [#] --- The number of entries of the lookup
+
+   The lookup is folded onto the positive y half by mirror symmetry. Reeds-Shepp paths are additionally symmetric under
+   reversal, so that the lookup is folded onto the positive x half as well.
+*/
+static const int dubinsLookupSize =
+    (reverse && !dubins ? dubinsLookupSteps + 1 : 2 * dubinsLookupSteps + 1) * (dubinsLookupSteps + 1) * headings;
 /// A structure describing the relative position of the occupied cell based on the center of the vehicle
 struct relPos
 {
     /// the x position relative to the center
-    int x;
+    int16_t x;
     /// the y position relative to the center
-    int y;
-};
-/// A structure capturing the lookup for each theta configuration
-struct config
-{
-    /// the number of cells occupied by this configuration of the vehicle
-    int length;
-    /*!
-       \var relPos pos[64]
-       \brief The maximum number of occupied cells
-       \todo needs to be dynamic
-    */
-    relPos pos[64];
+    int16_t y;
 };
 
 // _________________
@@ -0,0 +1,177 @@
+#ifndef FOOTPRINTTABLE_H
+#define FOOTPRINTTABLE_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "constants.h"
+
+namespace HybridAStar
+{
+/*!
+   \brief The rasterized footprints of the vehicle for all discrete positions within a cell and headings, built once
+   per number of headings and shared immutably by all collision detections.
+
+   The footprints are stored compressed: the cells of all configurations are packed into one array of 16 bit relative
+   positions, an array of offsets marks the first cell of each configuration. The size follows from the vehicle, there
+   is no limit on the number of cells. The cells of a configuration are sorted by decreasing distance from the center
+   of the vehicle, as the outermost cells are the likeliest to collide.
+
+   For the word parallel test every footprint is also stored as one 64 bit mask per row it covers, in the order of the
+   sorted cells, and by its bounding box.
+
+   The index of a configuration is (iY * Constants::positionResolution + iX) * headings + iT.
+
+   A table can also hold the swept footprints of the motion primitives, the cells covered by the vehicle between the
+   start and the end of a primitive, relative to the cell of its start. The index of a swept footprint is the index of
+   the configuration of the start times the number of primitives plus the primitive.
+*/
+class FootprintTable
+{
+public:
+    /// A row of a footprint, the cells it covers as bits relative to its first cell
+    struct Row
+    {
+        /// the y position of the row relative to the center
+        int y;
+        /// the x position of the first cell relative to the center
+        int x;
+        /// the cells covered, bit k for the cell x + k
+        uint64_t mask;
+    };
+
+    /// The bounding box of a footprint, relative to the center
+    struct Bounds
+    {
+        /// the lowest x position of a cell
+        int minX;
+        /// the lowest y position of a cell
+        int minY;
+        /// the highest x position of a cell
+        int maxX;
+        /// the highest y position of a cell
+        int maxY;
+    };
+
+    /*!
+       \brief Builds the table for the vehicle described in Constants
+       \param headings the number of headings
+    */
+    explicit FootprintTable(int headings);
+
+    /*!
+       \brief Builds the swept footprints of the motion primitives, the union of the footprints of the poses sampled
+       along the arc between the start and the end of every primitive for every configuration of the start, from every
+       start within the discrete position and heading of the configuration
+       \param footprints the footprints of the vehicle
+       \param dx the displacement of every primitive along the heading of its start
+       \param dy the displacement of every primitive perpendicular to the heading of its start
+       \param dt the change of heading of every primitive
+    */
+    FootprintTable(const FootprintTable& footprints, const std::vector<float>& dx, const std::vector<float>& dy,
+                   const std::vector<float>& dt);
+
+    /// Returns the table for the number of headings shared by all users, it is built on the first call
+    static std::shared_ptr<const FootprintTable> shared(int headings);
+
+    /// Returns the swept footprints of the primitives for the number of headings shared by all users, they are built on
+    /// the first call
+    static std::shared_ptr<const FootprintTable> shared(int headings, const std::vector<float>& dx,
+                                                        const std::vector<float>& dy, const std::vector<float>& dt);
+
+    /*!
+       \brief Computes the cell of the pose and the index of its configuration
+       \param x the x position
+       \param y the y position
+       \param t the theta angle
+       \param X the x position of the cell
+       \param Y the y position of the cell
+       \return the index of the configuration
+    */
+    int configuration(float x, float y, float t, int& X, int& Y) const
+    {
+        X      = (int)x;
+        Y      = (int)y;
+        int iX = (int)((x - (long)x) * Constants::positionResolution);
+        iX     = iX > 0 ? iX : 0;
+        int iY = (int)((y - (long)y) * Constants::positionResolution);
+        iY     = iY > 0 ? iY : 0;
+        int iT = (int)(t / deltaHeadingRad);
+        return iY * Constants::positionResolution * headings + iX * headings + iT;
+    }
+
+    /// get the number of headings
+    int getHeadings() const
+    {
+        return headings;
+    }
+    /// get the angle between two headings
+    float getDeltaHeadingRad() const
+    {
+        return deltaHeadingRad;
+    }
+    /// get the number of configurations
+    int size() const
+    {
+        return cellStart.size() - 1;
+    }
+    /// get the first cell of the configuration
+    const Constants::relPos* cellsBegin(int idx) const
+    {
+        return cells.data() + cellStart[idx];
+    }
+    /// get the end of the cells of the configuration
+    const Constants::relPos* cellsEnd(int idx) const
+    {
+        return cells.data() + cellStart[idx + 1];
+    }
+    /// get the first row of the configuration
+    const Row* rowsBegin(int idx) const
+    {
+        return rows.data() + rowStart[idx];
+    }
+    /// get the end of the rows of the configuration
+    const Row* rowsEnd(int idx) const
+    {
+        return rows.data() + rowStart[idx + 1];
+    }
+    /// get the bounding box of the configuration
+    const Bounds& getBounds(int idx) const
+    {
+        return bounds[idx];
+    }
+    /// get the largest displacement of a swept footprint in cells, zero for the footprints of single poses
+    float getReach() const
+    {
+        return reach;
+    }
+
+private:
+    /// Sorts the cells of the configuration by decreasing distance from the center relative to its cell
+    void sortCells(int idx, float cX, float cY);
+    /// Builds the row masks and the bounding boxes from the cells
+    void buildRows();
+
+    /// the number of headings
+    int headings;
+    /// the angle between two headings
+    float deltaHeadingRad;
+    /// the first cell of every configuration, followed by the end of the last one
+    std::vector<int> cellStart;
+    /// the cells of all configurations relative to the cell of the vehicle
+    std::vector<Constants::relPos> cells;
+    /// the first row of every configuration, followed by the end of the last one
+    std::vector<int> rowStart;
+    /// the rows of all configurations
+    std::vector<Row> rows;
+    /// the bounding box of every configuration
+    std::vector<Bounds> bounds;
+    /// the largest displacement of a swept footprint
+    float reach;
+};
+}  // namespace HybridAStar
+#endif  // FOOTPRINTTABLE_H
@@ -0,0 +1,67 @@
+#ifndef HEURISTIC_H
+#define HEURISTIC_H
+
+#include "constants.h"
+#include "holonomicheuristic.h"
+#include "node3d.h"
+
+namespace HybridAStar
+{
+/*!
+   \brief The poses of the successors of one expansion as structure of arrays, the input of Heuristic::evaluate
+*/
+struct HeuristicBatch
+{
+    /// The maximum number of poses of a batch, a multiple of the widest vector
+    static const int capacity = 16;
+
+    /// Removes all poses
+    void clear()
+    {
+        size = 0;
+    }
+    /// Appends the pose of the node, returns its lane
+    int push(const Node3D& node)
+    {
+        x[size] = node.getX();
+        y[size] = node.getY();
+        t[size] = node.getT();
+        return size++;
+    }
+
+    /// the x positions
+    alignas(32) float x[capacity];
+    /// the y positions
+    alignas(32) float y[capacity];
+    /// the headings
+    alignas(32) float t[capacity];
+    /// the resulting cost-to-go
+    alignas(32) float h[capacity];
+    /// the number of poses
+    int size = 0;
+};
+
+/*!
+   \brief The cost-to-go of the search, the maximum of the non-holonomic without obstacles heuristic (Reeds-Shepp or
+   Dubin's, looked up or computed analytically) and the holonomic with obstacles heuristic.
+
+   The heuristic is evaluated for all successors of an expansion at once. The relative poses, the lookup indices and
+   the 2D term are computed by AVX2 or SSE2 kernels depending on the instruction set the planner is compiled for, with a
+   scalar fallback. Only the poses outside of the lookup are computed analytically one by one. The kernels assume
+   headings normalized to [0, 2PI].
+*/
+class Heuristic
+{
+public:
+    /*!
+       \brief Computes the cost-to-go for all poses of the batch
+       \param batch the poses, the result is written to batch.h
+       \param goal the goal pose
+       \param holonomic the cost-to-goal field of the holonomic with obstacles heuristic
+       \param dubinsLookup the lookup of the lengths of analytical solutions or a nullptr while it is not available
+    */
+    static void evaluate(HeuristicBatch& batch, const Node3D& goal, const HolonomicHeuristic& holonomic,
+                         const float* dubinsLookup);
+};
+}  // namespace HybridAStar
+#endif  // HEURISTIC_H
@@ -0,0 +1,120 @@
+#ifndef HOLONOMICHEURISTIC_H
+#define HOLONOMICHEURISTIC_H
+
+#include <nav_msgs/OccupancyGrid.h>
+
+#include <limits>
+#include <vector>
+
+#include "constants.h"
+#include "indexedheap.h"
+#include "node2d.h"
+
+namespace HybridAStar
+{
+/*!
+   \brief The holonomic with obstacles heuristic as a cost-to-goal field over the whole grid.
+
+   The field is computed by a single backward Dijkstra sweep from the goal cell on the eight-connected grid, using the
+   same movement cost as the 2D nodes. It is cached until the map or the goal cell changes, so that the heuristic of a
+   node is a single lookup.
+
+   When a map of the same size only differs in a few cells, the field is repaired incrementally in the manner of
+   LPA*: every cell additionally keeps its one-step lookahead cost rhs, and only the cells that become inconsistent
+   through the change are processed. The cost of the repair is proportional to the region whose cost-to-go changes.
+*/
+class HolonomicHeuristic
+{
+public:
+    /// The default constructor
+    HolonomicHeuristic() : width(0), height(0), goalX(-1), goalY(-1), valid(false)
+    {
+    }
+
+    /*!
+       \brief Sets the map the field is computed on and invalidates the field
+       \param map the map or occupancy grid
+    */
+    void setMap(const nav_msgs::OccupancyGrid::Ptr& map);
+
+    /*!
+       \brief Sets a map of the same size whose occupancy only differs in the given cells, the field is repaired
+       \param map the map or occupancy grid
+       \param changed the indices of the cells whose occupancy changed
+    */
+    void updateMap(const nav_msgs::OccupancyGrid::Ptr& map, const std::vector<int>& changed);
+
+    /*!
+       \brief Computes the field for the given goal cell unless it is already cached
+       \param x the x position of the goal cell
+       \param y the y position of the goal cell
+    */
+    void setGoal(int x, int y);
+
+    /*!
+       \brief Returns the cost of the shortest 2D path from the cell to the goal
+       \param x the x position of the cell
+       \param y the y position of the cell
+       \return the cost-to-go or infinity if the goal can not be reached
+    */
+    float getCost(int x, int y) const
+    {
+        return cost[y * width + x];
+    }
+
+    /// Returns whether the goal can be reached from the cell
+    bool isReachable(int x, int y) const
+    {
+        return cost[y * width + x] != unreachable;
+    }
+
+    /// get the cost-to-go of all cells in row-major order, for vectorized lookups
+    const float* getCosts() const
+    {
+        return cost.data();
+    }
+    /// get the width of the field in number of cells
+    int getWidth() const
+    {
+        return width;
+    }
+
+    /// The cost of cells from which the goal can not be reached
+    static constexpr float unreachable = std::numeric_limits<float>::infinity();
+
+private:
+    /// Runs the backward Dijkstra sweep from the goal cell
+    void sweep();
+    /// Repairs the field after the occupancy of the pending cells changed
+    void repair();
+    /// Recomputes the lookahead cost of a cell and queues it if it is inconsistent
+    void updateCell(int idx);
+    /// Determines whether the cell is blocked by an obstacle
+    bool isBlocked(int idx) const
+    {
+        return grid->data[idx] != 0;
+    }
+
+    /// The occupancy grid
+    nav_msgs::OccupancyGrid::Ptr grid;
+    /// the width of the grid in number of cells
+    int width;
+    /// the height of the grid in number of cells
+    int height;
+    /// the x position of the goal cell the field has been computed for
+    int goalX;
+    /// the y position of the goal cell the field has been computed for
+    int goalY;
+    /// whether the field is valid for the current map and goal
+    bool valid;
+    /// the cost-to-go of every cell
+    std::vector<float> cost;
+    /// the one-step lookahead cost-to-go of every cell
+    std::vector<float> rhs;
+    /// the cells whose occupancy changed since the field has last been updated
+    std::vector<int> pending;
+    /// the open list of cell indices, kept to reuse its memory
+    IndexedHeap open;
+};
+}  // namespace HybridAStar
+#endif  // HOLONOMICHEURISTIC_H
@@ -0,0 +1,216 @@
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+
+#include <vector>
+
+namespace HybridAStar
+{
+/*!
+   \brief A 4-ary min-heap of (key, id) pairs in a contiguous array with a map from ids to heap positions.
+
+   Every id is contained at most once. Pushing an id that is already contained changes its key and restores the heap
+   order, so that open lists do not accumulate stale entries that have to be skipped by lazy deletion. The four
+   children of a position are adjacent in memory and the heap is half as deep as a binary heap.
+
+   Ids are small non-negative integers, e.g. positions in a node store or cell indices. The position map grows with
+   the largest id seen and is kept across clear() calls.
+*/
+class IndexedHeap
+{
+public:
+    /// Removes all entries, in proportion to the number of remaining entries
+    void clear()
+    {
+        for (const Entry& entry : heap)
+        {
+            position[entry.id] = -1;
+        }
+
+        heap.clear();
+    }
+
+    /// Reserves the position map for the ids [0, ids)
+    void reserve(int ids)
+    {
+        if (ids > (int)position.size())
+        {
+            position.resize(ids, -1);
+        }
+    }
+
+    /// Determines whether the heap is empty
+    bool empty() const
+    {
+        return heap.empty();
+    }
+    /// get the number of entries
+    int size() const
+    {
+        return heap.size();
+    }
+    /// Determines whether the id is contained
+    bool contains(int id) const
+    {
+        return id < (int)position.size() && position[id] >= 0;
+    }
+    /// get the id with the lowest key
+    int top() const
+    {
+        return heap[0].id;
+    }
+    /// get the lowest key
+    float topKey() const
+    {
+        return heap[0].key;
+    }
+
+    /*!
+       \brief Inserts the id or changes its key if it is already contained
+       \param id the id
+       \param key the key
+    */
+    void push(int id, float key)
+    {
+        reserve(id + 1);
+
+        int i = position[id];
+
+        if (i < 0)
+        {
+            heap.push_back(Entry{key, id});
+            siftUp(heap.size() - 1);
+        }
+        else if (key < heap[i].key)
+        {
+            heap[i].key = key;
+            siftUp(i);
+        }
+        else
+        {
+            heap[i].key = key;
+            siftDown(i);
+        }
+    }
+
+    /// Removes the id with the lowest key
+    void pop()
+    {
+        removeAt(0);
+    }
+
+    /// Removes the id if it is contained
+    void remove(int id)
+    {
+        if (contains(id))
+        {
+            removeAt(position[id]);
+        }
+    }
+
+private:
+    /// An entry of the heap
+    struct Entry
+    {
+        /// the key
+        float key;
+        /// the id
+        int id;
+    };
+
+    /// The number of children of a position
+    static const int arity = 4;
+
+    /// Removes the entry at position i and restores the heap order
+    void removeAt(int i)
+    {
+        position[heap[i].id] = -1;
+        Entry last           = heap.back();
+        heap.pop_back();
+
+        if (i < (int)heap.size())
+        {
+            heap[i]           = last;
+            position[last.id] = i;
+
+            if (i > 0 && last.key < heap[(i - 1) / arity].key)
+            {
+                siftUp(i);
+            }
+            else
+            {
+                siftDown(i);
+            }
+        }
+    }
+
+    /// Moves the entry at position i up until its parent is not larger
+    void siftUp(int i)
+    {
+        Entry entry = heap[i];
+
+        while (i > 0)
+        {
+            int parent = (i - 1) / arity;
+
+            if (!(entry.key < heap[parent].key))
+            {
+                break;
+            }
+
+            heap[i]              = heap[parent];
+            position[heap[i].id] = i;
+            i                    = parent;
+        }
+
+        heap[i]            = entry;
+        position[entry.id] = i;
+    }
+
+    /// Moves the entry at position i down until no child is smaller
+    void siftDown(int i)
+    {
+        Entry entry = heap[i];
+        int   n     = heap.size();
+
+        for (;;)
+        {
+            int first = arity * i + 1;
+
+            if (first >= n)
+            {
+                break;
+            }
+
+            // the smallest of up to four children
+            int best = first;
+            int last = first + arity < n ? first + arity : n;
+
+            for (int child = first + 1; child < last; ++child)
+            {
+                if (heap[child].key < heap[best].key)
+                {
+                    best = child;
+                }
+            }
+
+            if (!(heap[best].key < entry.key))
+            {
+                break;
+            }
+
+            heap[i]              = heap[best];
+            position[heap[i].id] = i;
+            i                    = best;
+        }
+
+        heap[i]            = entry;
+        position[entry.id] = i;
+    }
+
+    /// the heap in level order
+    std::vector<Entry> heap;
+    /// the position of every id in the heap or -1 if it is not contained
+    std::vector<int> position;
+};
+}  // namespace HybridAStar
+#endif  // INDEXEDHEAP_H
@@ -1,76 +1,214 @@
 #ifndef COLLISIONLOOKUP
 #define COLLISIONLOOKUP
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
 #include "constants.h"
 #include "dubins.h"
+#include "reedsshepp.h"
 
 namespace HybridAStar
 {
 namespace Lookup
 {
 
+//###################################################
+//                                PARALLEL GENERATION
+//###################################################
+/*!
+   \brief Calls the body for every item in [0, n) on all hardware threads
+
+   The items are handed out one at a time, so the body has to write only to the outputs of its item for the result to
+   be independent of the scheduling.
+
+   \param n the number of items
+   \param body the function called with the item
+*/
+template <typename Body>
+inline void parallelFor(int n, const Body& body)
+{
+    std::atomic<int>         next(0);
+    std::vector<std::thread> workers;
+    const int                count = std::min<int>(n, std::max(1u, std::thread::hardware_concurrency()));
+
+    auto work = [&]() {
+        for (int i = next++; i < n; i = next++)
+        {
+            body(i);
+        }
+    };
+
+    for (int w = 1; w < count; ++w)
+    {
+        workers.emplace_back(work);
+    }
+
+    work();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
 //###################################################
 //                                      DUBINS LOOKUP
 //###################################################
-inline void dubinsLookup(float* lookup)
+
+// _________________________________
+// LENGTH OF THE ANALYTICAL SOLUTION
+/*!
+   \brief Computes the length of the shortest path from the origin with heading zero to the given pose
+   \param x the x position of the pose relative to the origin
+   \param y the y position of the pose relative to the origin
+   \param t the heading of the pose relative to the origin
+   \return the length of the Reeds-Shepp path if reversing is enabled, else of the Dubin's path
+*/
+inline float analyticalLength(double x, double y, double t)
 {
-    bool DEBUG = false;
-    std::cout << "I am building the Dubin's lookup table...";
+    double q0[] = {0, 0, 0};
+    double q1[] = {x, y, t};
+
+    if (Constants::reverse && !Constants::dubins)
+    {
+        return reeds_shepp_distance(q0, q1, Constants::r);
+    }
 
     DubinsPath path;
+    dubins_init(q0, q1, Constants::r, &path);
+    return dubins_path_length(&path);
+}
 
-    int width = Constants::dubinsWidth / Constants::cellSize;
+// ___________________
+// INDEX OF THE LOOKUP
+/*!
+   \brief Determines the entry of the lookup for the relative pose of the goal in the frame of the start
+
+   The pose is folded onto the positive y half by mirroring it on the x axis, which negates the heading. Without
+   reversing this is the only symmetry, with reversing the pose is also mirrored on the y axis, which negates the
+   heading again. The position is rounded to the resolution of the collision lookup and the heading to the nearest
+   heading of the search.
+
+   \param x the x position of the goal relative to the start
+   \param y the y position of the goal relative to the start
+   \param t the heading of the goal relative to the start
+   \return the index of the entry or -1 if the pose is outside of the lookup
+*/
+inline int dubinsLookupIndex(float x, float y, float t)
+{
+    const int steps = Constants::dubinsLookupSteps;
 
-    //  // increase the width by one to make it square
-    //  if (width % 2 != 0) {
-    //    width++;
-    //  }
+    // mirror on the x axis
+    if (y < 0)
+    {
+        y = -y;
+        t = -t;
+    }
 
-    const int headings = Constants::headings;
+    // mirror on the y axis, a Reeds-Shepp path driven backwards
+    if (Constants::reverse && !Constants::dubins && x < 0)
+    {
+        x = -x;
+        t = -t;
+    }
 
-    // start and goal vector
-    double start[3];
-    double goal[] = {0, 0, 0};
+    int X = (int)std::floor(x * Constants::positionResolution + 0.5f);
+    int Y = (int)std::floor(y * Constants::positionResolution + 0.5f);
 
-    // iterate over the X index of a grid cell
-    for (int X = 0; X < width; ++X)
+    if (Y > steps || X > steps || X < -steps)
     {
-        start[0] = X;
+        return -1;
+    }
 
-        // iterate over the Y index of a grid cell
-        for (int Y = 0; Y < width; ++Y)
-        {
-            start[1] = Y;
+    // without the mirror on the y axis the x position spans both sides
+    if (!Constants::reverse || Constants::dubins)
+    {
+        X += steps;
+    }
+
+    t     = std::fmod(t, 2 * (float)M_PI);
+    int H = (int)std::floor((t < 0 ? t + 2 * (float)M_PI : t) / Constants::deltaHeadingRad + 0.5f) % Constants::headings;
+
+    return (X * (steps + 1) + Y) * Constants::headings + H;
+}
+
+// ___________________
+// LOOKUP CREATION
+/*!
+   \brief Fills the lookup with lower bounds of the lengths of the analytical solutions for all relative poses within
+   Constants::dubinsWidth, see dubinsLookupIndex for the layout
+
+   A relative pose is rounded to the closest entry, so that an entry holds the minimum of the lengths at its pose and
+   at the neighbouring poses in x, y and heading, which enclose all poses rounded to it. The lookup thus never exceeds
+   the length of the analytical solution and the heuristic stays admissible.
+
+   The relative x positions are computed in parallel, each writes only to its own entries.
+
+   \param lookup the lookup of Constants::dubinsLookupSize entries
+*/
+inline void dubinsLookup(float* lookup)
+{
+    std::cout << "I am building the Dubin's lookup table...";
 
-            // iterate over the start headings
-            for (int h0 = 0; h0 < headings; ++h0)
+    const int   steps    = Constants::dubinsLookupSteps;
+    const int   headings = Constants::headings;
+    const float step     = 1.f / Constants::positionResolution;
+    const float delta    = Constants::deltaHeadingRad;
+    // without the mirror on the y axis the x position spans both sides
+    const int xMin = Constants::reverse && !Constants::dubins ? 0 : -steps;
+    // the lengths at the discrete poses
+    std::vector<float> lengths(Constants::dubinsLookupSize);
+
+    // iterate over the relative x position
+    parallelFor(steps - xMin + 1, [&](int item) {
+        const int X = xMin + item;
+
+        // iterate over the relative y position
+        for (int Y = 0; Y <= steps; ++Y)
+        {
+            // iterate over the relative headings
+            for (int h = 0; h < headings; ++h)
             {
-                start[2] = Constants::deltaHeadingRad * h0;
+                lengths[dubinsLookupIndex(X * step, Y * step, h * delta)] =
+                    analyticalLength(X * step, Y * step, h * delta);
+            }
+        }
+    });
 
-                // iterate over the goal headings
-                for (int h1 = 0; h1 < headings; ++h1)
-                {
-                    goal[2] = Constants::deltaHeadingRad * h1;
+    // _______________
+    // THE LOWER BOUND
+    // the neighbours across the mirrored axes are entries of the lookup as well, beyond its border they are computed
+    parallelFor(steps - xMin + 1, [&](int item) {
+        const int X = xMin + item;
 
-                    // calculate the actual cost
-                    dubins_init(start, goal, Constants::r, &path);
-                    lookup[X * headings * headings * width + Y * headings * headings + h0 * headings + h1] =
-                        dubins_path_length(&path);
+        for (int Y = 0; Y <= steps; ++Y)
+        {
+            for (int h = 0; h < headings; ++h)
+            {
+                float length = lengths[dubinsLookupIndex(X * step, Y * step, h * delta)];
 
-                    if (DEBUG &&
-                        lookup[X * headings * headings * width + Y * headings * headings + h0 * headings + h1] <
-                            sqrt(X * X + Y * Y) * 1.000001)
+                for (int nX = X - 1; nX <= X + 1; ++nX)
+                {
+                    for (int nY = Y - 1; nY <= Y + 1; ++nY)
                     {
-                        std::cout << X << " | " << Y << " | " << Constants::deltaHeadingDeg * h0 << " | "
-                                  << Constants::deltaHeadingDeg * h1 << " length: "
-                                  << lookup[X * headings * headings * width + Y * headings * headings + h0 * headings +
-                                            h1]
-                                  << "\n";
+                        for (int nH = h - 1; nH <= h + 1; ++nH)
+                        {
+                            int idx = dubinsLookupIndex(nX * step, nY * step, nH * delta);
+                            length  = std::min(length, idx >= 0 ? lengths[idx]
+                                                                : analyticalLength(nX * step, nY * step, nH * delta));
+                        }
                     }
                 }
+
+                lookup[dubinsLookupIndex(X * step, Y * step, h * delta)] = length;
             }
         }
-    }
+    });
 
     std::cout << " done!" << std::endl;
 }
@@ -93,12 +231,18 @@ inline int sign(double x)
     }
 }
 
-// _________________________
-// COLLISION LOOKUP CREATION
-inline void collisionLookup(Constants::config* lookup)
+// ______________________________________
+// COLLISION LOOKUP CREATION FOR A POSITION
+/*!
+   \brief Rasterizes the footprint of the vehicle for every heading at one discrete position within a cell
+   \param q the discrete position, iY * Constants::positionResolution + iX
+   \param headings the number of headings
+   \param ends the end of the cells of every heading in cells
+   \param cells the cells occupied by the configurations relative to the cell of the vehicle
+*/
+inline void collisionLookupPosition(int q, int headings, std::vector<int>& ends, std::vector<Constants::relPos>& cells)
 {
     bool DEBUG = false;
-    std::cout << "I am building the collision lookup table...";
     // cell size
     const float cSize = Constants::cellSize;
     // bounding box size length/width
@@ -152,6 +296,11 @@ inline void collisionLookup(Constants::config* lookup)
     const int positionResolution = Constants::positionResolution;
     const int positions          = Constants::positions;
     point     points[positions];
+    // the angle between two headings
+    const float deltaHeadingRad = 2 * M_PI / (float)headings;
+
+    ends.assign(headings, 0);
+    cells.clear();
 
     // generate all discrete positions within one cell
     for (int i = 0; i < positionResolution; ++i)
@@ -163,241 +312,274 @@ inline void collisionLookup(Constants::config* lookup)
         }
     }
 
-    for (int q = 0; q < positions; ++q)
-    {
-        // set the starting angle to zero;
-        theta = 0;
+    // set the starting angle to zero;
+    theta = 0;
+
+    // set points of rectangle
+    c.x = (double)size / 2 + points[q].x;
+    c.y = (double)size / 2 + points[q].y;
 
-        // set points of rectangle
-        c.x = (double)size / 2 + points[q].x;
-        c.y = (double)size / 2 + points[q].y;
+    p[0].x = c.x - Constants::length / 2 / cSize;
+    p[0].y = c.y - Constants::width / 2 / cSize;
 
-        p[0].x = c.x - Constants::length / 2 / cSize;
-        p[0].y = c.y - Constants::width / 2 / cSize;
+    p[1].x = c.x - Constants::length / 2 / cSize;
+    p[1].y = c.y + Constants::width / 2 / cSize;
 
-        p[1].x = c.x - Constants::length / 2 / cSize;
-        p[1].y = c.y + Constants::width / 2 / cSize;
+    p[2].x = c.x + Constants::length / 2 / cSize;
+    p[2].y = c.y + Constants::width / 2 / cSize;
 
-        p[2].x = c.x + Constants::length / 2 / cSize;
-        p[2].y = c.y + Constants::width / 2 / cSize;
+    p[3].x = c.x + Constants::length / 2 / cSize;
+    p[3].y = c.y - Constants::width / 2 / cSize;
 
-        p[3].x = c.x + Constants::length / 2 / cSize;
-        p[3].y = c.y - Constants::width / 2 / cSize;
+    for (int o = 0; o < headings; ++o)
+    {
+        if (DEBUG)
+        {
+            std::cout << "\ndegrees: " << theta * 180.f / M_PI << std::endl;
+        }
 
-        for (int o = 0; o < Constants::headings; ++o)
+        // initialize cSpace
+        for (int i = 0; i < size; ++i)
         {
-            if (DEBUG)
+            for (int j = 0; j < size; ++j)
             {
-                std::cout << "\ndegrees: " << theta * 180.f / M_PI << std::endl;
+                cSpace[i * size + j] = false;
             }
+        }
 
-            // initialize cSpace
-            for (int i = 0; i < size; ++i)
+        // shape rotation
+        for (int j = 0; j < 4; ++j)
+        {
+            // translate point to origin
+            temp.x = p[j].x - c.x;
+            temp.y = p[j].y - c.y;
+
+            // rotate and shift back
+            nP[j].x = temp.x * cos(theta) - temp.y * sin(theta) + c.x;
+            nP[j].y = temp.x * sin(theta) + temp.y * cos(theta) + c.y;
+        }
+
+        // create the next angle
+        theta += deltaHeadingRad;
+
+        // cell traversal clockwise
+        for (int k = 0; k < 4; ++k)
+        {
+            // create the vectors clockwise
+            if (k < 3)
             {
-                for (int j = 0; j < size; ++j)
-                {
-                    cSpace[i * size + j] = false;
-                }
+                start = nP[k];
+                end   = nP[k + 1];
             }
-
-            // shape rotation
-            for (int j = 0; j < 4; ++j)
+            else
             {
-                // translate point to origin
-                temp.x = p[j].x - c.x;
-                temp.y = p[j].y - c.y;
-
-                // rotate and shift back
-                nP[j].x = temp.x * cos(theta) - temp.y * sin(theta) + c.x;
-                nP[j].y = temp.x * sin(theta) + temp.y * cos(theta) + c.y;
+                start = nP[k];
+                end   = nP[0];
             }
 
-            // create the next angle
-            theta += Constants::deltaHeadingRad;
-
-            // cell traversal clockwise
-            for (int k = 0; k < 4; ++k)
+            // set indexes
+            X = (int)start.x;
+            Y = (int)start.y;
+            //      std::cout << "StartCell: " << X << "," << Y << std::endl;
+            cSpace[Y * size + X] = true;
+            t.x                  = end.x - start.x;
+            t.y                  = end.y - start.y;
+            stepX                = sign(t.x);
+            stepY                = sign(t.y);
+
+            // width and height normalized by t
+            if (t.x != 0)
             {
-                // create the vectors clockwise
-                if (k < 3)
-                {
-                    start = nP[k];
-                    end   = nP[k + 1];
-                }
-                else
-                {
-                    start = nP[k];
-                    end   = nP[0];
-                }
+                tDeltaX = 1.f / std::abs(t.x);
+            }
+            else
+            {
+                tDeltaX = 1000;
+            }
 
-                // set indexes
-                X = (int)start.x;
-                Y = (int)start.y;
-                //      std::cout << "StartCell: " << X << "," << Y << std::endl;
-                cSpace[Y * size + X] = true;
-                t.x                  = end.x - start.x;
-                t.y                  = end.y - start.y;
-                stepX                = sign(t.x);
-                stepY                = sign(t.y);
-
-                // width and height normalized by t
-                if (t.x != 0)
-                {
-                    tDeltaX = 1.f / std::abs(t.x);
-                }
-                else
-                {
-                    tDeltaX = 1000;
-                }
+            if (t.y != 0)
+            {
+                tDeltaY = 1.f / std::abs(t.y);
+            }
+            else
+            {
+                tDeltaY = 1000;
+            }
 
-                if (t.y != 0)
-                {
-                    tDeltaY = 1.f / std::abs(t.y);
-                }
-                else
-                {
-                    tDeltaY = 1000;
-                }
+            // set maximum traversal values
+            if (stepX > 0)
+            {
+                tMaxX = tDeltaX * (1 - (start.x - (long)start.x));
+            }
+            else
+            {
+                tMaxX = tDeltaX * (start.x - (long)start.x);
+            }
 
-                // set maximum traversal values
-                if (stepX > 0)
-                {
-                    tMaxX = tDeltaX * (1 - (start.x - (long)start.x));
-                }
-                else
-                {
-                    tMaxX = tDeltaX * (start.x - (long)start.x);
-                }
+            if (stepY > 0)
+            {
+                tMaxY = tDeltaY * (1 - (start.y - (long)start.y));
+            }
+            else
+            {
+                tMaxY = tDeltaY * (start.y - (long)start.y);
+            }
 
-                if (stepY > 0)
+            while ((int)end.x != X || (int)end.y != Y)
+            {
+                // only increment x if the t length is smaller and the result will be closer to the goal
+                if (tMaxX < tMaxY && std::abs(X + stepX - (int)end.x) < std::abs(X - (int)end.x))
                 {
-                    tMaxY = tDeltaY * (1 - (start.y - (long)start.y));
+                    tMaxX                = tMaxX + tDeltaX;
+                    X                    = X + stepX;
+                    cSpace[Y * size + X] = true;
+                    // only increment y if the t length is smaller and the result will be closer to the goal
                 }
-                else
+                else if (tMaxY < tMaxX && std::abs(Y + stepY - (int)end.y) < std::abs(Y - (int)end.y))
                 {
-                    tMaxY = tDeltaY * (start.y - (long)start.y);
+                    tMaxY                = tMaxY + tDeltaY;
+                    Y                    = Y + stepY;
+                    cSpace[Y * size + X] = true;
                 }
-
-                while ((int)end.x != X || (int)end.y != Y)
+                else if (2 >= std::abs(X - (int)end.x) + std::abs(Y - (int)end.y))
                 {
-                    // only increment x if the t length is smaller and the result will be closer to the goal
-                    if (tMaxX < tMaxY && std::abs(X + stepX - (int)end.x) < std::abs(X - (int)end.x))
+                    if (std::abs(X - (int)end.x) > std::abs(Y - (int)end.y))
                     {
-                        tMaxX                = tMaxX + tDeltaX;
                         X                    = X + stepX;
                         cSpace[Y * size + X] = true;
-                        // only increment y if the t length is smaller and the result will be closer to the goal
                     }
-                    else if (tMaxY < tMaxX && std::abs(Y + stepY - (int)end.y) < std::abs(Y - (int)end.y))
+                    else
                     {
-                        tMaxY                = tMaxY + tDeltaY;
                         Y                    = Y + stepY;
                         cSpace[Y * size + X] = true;
                     }
-                    else if (2 >= std::abs(X - (int)end.x) + std::abs(Y - (int)end.y))
-                    {
-                        if (std::abs(X - (int)end.x) > std::abs(Y - (int)end.y))
-                        {
-                            X                    = X + stepX;
-                            cSpace[Y * size + X] = true;
-                        }
-                        else
-                        {
-                            Y                    = Y + stepY;
-                            cSpace[Y * size + X] = true;
-                        }
-                    }
-                    else
-                    {
-                        // this SHOULD NOT happen
-                        std::cout << "\n--->tie occured, please check for error in script\n";
-                        break;
-                    }
+                }
+                else
+                {
+                    // this SHOULD NOT happen
+                    std::cout << "\n--->tie occured, please check for error in script\n";
+                    break;
                 }
             }
+        }
 
-            // FILL THE SHAPE
-            for (int i = 0; i < size; ++i)
-            {
-                // set inside to false
-                inside = false;
+        // FILL THE SHAPE
+        for (int i = 0; i < size; ++i)
+        {
+            // set inside to false
+            inside = false;
 
-                for (int j = 0; j < size; ++j)
+            for (int j = 0; j < size; ++j)
+            {
+                // determine horizontal crossings
+                for (int k = 0; k < size; ++k)
                 {
-                    // determine horizontal crossings
-                    for (int k = 0; k < size; ++k)
+                    if (cSpace[i * size + k] && !inside)
                     {
-                        if (cSpace[i * size + k] && !inside)
-                        {
-                            hcross1 = k;
-                            inside  = true;
-                        }
-
-                        if (cSpace[i * size + k] && inside)
-                        {
-                            hcross2 = k;
-                        }
+                        hcross1 = k;
+                        inside  = true;
                     }
 
-                    // if inside fill
-                    if (j > hcross1 && j < hcross2 && inside)
+                    if (cSpace[i * size + k] && inside)
                     {
-                        cSpace[i * size + j] = true;
+                        hcross2 = k;
                     }
                 }
+
+                // if inside fill
+                if (j > hcross1 && j < hcross2 && inside)
+                {
+                    cSpace[i * size + j] = true;
+                }
+            }
+        }
+
+        // GENERATE THE ACTUAL LOOKUP
+        count = 0;
+
+        for (int i = 0; i < size; ++i)
+        {
+            for (int j = 0; j < size; ++j)
+            {
+                if (cSpace[i * size + j])
+                {
+                    // compute the relative position of the car cells
+                    cells.push_back(Constants::relPos{(int16_t)(j - (int)c.x), (int16_t)(i - (int)c.y)});
+                    // add one for the length of the current list
+                    count++;
+                }
             }
+        }
 
-            // GENERATE THE ACTUAL LOOKUP
-            count = 0;
+        ends[o] = cells.size();
 
+        if (DEBUG)
+        {
+            // DEBUG
             for (int i = 0; i < size; ++i)
             {
+                std::cout << "\n";
+
                 for (int j = 0; j < size; ++j)
                 {
                     if (cSpace[i * size + j])
                     {
-                        // compute the relative position of the car cells
-                        lookup[q * Constants::headings + o].pos[count].x = j - (int)c.x;
-                        lookup[q * Constants::headings + o].pos[count].y = i - (int)c.y;
-                        // add one for the length of the current list
-                        count++;
+                        std::cout << "#";
+                    }
+                    else
+                    {
+                        std::cout << ".";
                     }
                 }
             }
 
-            lookup[q * Constants::headings + o].length = count;
+            // TESTING
+            std::cout << "\n\nthe center of " << q * headings + o << " is at " << c.x << " | " << c.y
+                      << std::endl;
 
-            if (DEBUG)
+            for (int i = 0; i < count; ++i)
             {
-                // DEBUG
-                for (int i = 0; i < size; ++i)
-                {
-                    std::cout << "\n";
+                std::cout << "[" << i << "]\t" << cells[ends[o] - count + i].x << " | "
+                          << cells[ends[o] - count + i].y << std::endl;
+            }
+        }
+    }
+}
 
-                    for (int j = 0; j < size; ++j)
-                    {
-                        if (cSpace[i * size + j])
-                        {
-                            std::cout << "#";
-                        }
-                        else
-                        {
-                            std::cout << ".";
-                        }
-                    }
-                }
+// _________________________
+// COLLISION LOOKUP CREATION
+/*!
+   \brief Rasterizes the footprint of the vehicle for every discrete position within a cell and heading
 
-                // TESTING
-                std::cout << "\n\nthe center of " << q * Constants::headings + o << " is at " << c.x << " | " << c.y
-                          << std::endl;
+   The positions are rasterized in parallel and concatenated in order, the result equals the one of a serial build.
 
-                for (int i = 0; i < lookup[q * Constants::headings + o].length; ++i)
-                {
-                    std::cout << "[" << i << "]\t" << lookup[q * Constants::headings + o].pos[i].x << " | "
-                              << lookup[q * Constants::headings + o].pos[i].y << std::endl;
-                }
-            }
+   \param headings the number of headings
+   \param offsets the first cell of every configuration in cells, followed by the end of the last one
+   \param cells the cells occupied by the configurations relative to the cell of the vehicle
+*/
+inline void collisionLookup(int headings, std::vector<int>& offsets, std::vector<Constants::relPos>& cells)
+{
+    std::cout << "I am building the collision lookup table...";
+
+    const int                                   positions = Constants::positions;
+    std::vector<std::vector<int>>               ends(positions);
+    std::vector<std::vector<Constants::relPos>> positionCells(positions);
+
+    parallelFor(positions, [&](int q) { collisionLookupPosition(q, headings, ends[q], positionCells[q]); });
+
+    // ___________
+    // CONCATENATE
+    offsets.assign(positions * headings + 1, 0);
+    cells.clear();
+
+    for (int q = 0; q < positions; ++q)
+    {
+        for (int o = 0; o < headings; ++o)
+        {
+            offsets[q * headings + o + 1] = cells.size() + ends[q][o];
         }
+
+        cells.insert(cells.end(), positionCells[q].begin(), positionCells[q].end());
     }
 
     std::cout << " done!" << std::endl;
@@ -0,0 +1,103 @@
+#ifndef LOOKUPCACHE_H
+#define LOOKUPCACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "constants.h"
+
+namespace HybridAStar
+{
+/*!
+   \brief Provides the lookup of the lengths of analytical solutions, persisted in a binary file across restarts.
+
+   The file starts with a header holding a magic number, the version of the format, the key of the configuration the
+   lookup was built for (the vehicle, the number of headings and the resolution), the number of entries and a checksum
+   of the entries. If the key and the checksum match, the file is memory mapped and the lookup is available
+   immediately. Otherwise the lookup is built on a background thread and written to the file, until it is available
+   the lookup is a nullptr and the lengths are computed analytically.
+*/
+class LookupCache
+{
+public:
+    /// The default constructor, no lookup is available
+    LookupCache();
+    /// Waits for a running build and unmaps the file
+    ~LookupCache();
+
+    LookupCache(const LookupCache&) = delete;
+    LookupCache& operator=(const LookupCache&) = delete;
+
+    /*!
+       \brief Maps the lookup from the file if it matches the constants, else starts building it in the background
+       \param path the path of the file
+    */
+    void open(const std::string& path);
+
+    /// Blocks until a running build has finished
+    void wait();
+
+    /// get the lookup of the lengths of analytical solutions, a nullptr while it is being built
+    const float* getDubinsLookup() const
+    {
+        return dubinsLookup.load(std::memory_order_acquire);
+    }
+
+private:
+    /// The key of the configuration the lookup is valid for
+    struct Key
+    {
+        int32_t headings;
+        int32_t positionResolution;
+        int32_t dubinsWidth;
+        int32_t reedsShepp;
+        float   cellSize;
+        float   r;
+        float   length;
+        float   width;
+    };
+
+    /// The header of the file
+    struct Header
+    {
+        /// identifies the file
+        char magic[8];
+        /// the version of the format
+        uint32_t version;
+        /// the configuration the lookup was built for
+        Key key;
+        /// the number of entries
+        uint64_t size;
+        /// the checksum of the entries
+        uint64_t checksum;
+    };
+
+    /// The version of the format, to be increased with any change to the file or the layout of the lookup
+    static const uint32_t version = 2;
+
+    /// Creates the header for the current constants
+    static Header header();
+    /// Computes the FNV-1a checksum of the data
+    static uint64_t checksum(const void* data, size_t bytes);
+    /// Maps the file, returns whether it matches the current constants
+    bool map(const std::string& path);
+    /// Builds the lookup, publishes it and writes it to the file
+    void build(const std::string& path);
+
+    /// the lookup that is used, a nullptr until it is available
+    std::atomic<const float*> dubinsLookup;
+    /// the mapped file or a nullptr
+    void* mapping;
+    /// the size of the mapped file
+    size_t mappingSize;
+    /// the lookup if it has been built
+    std::vector<float> table;
+    /// the thread building the lookup
+    std::thread builder;
+};
+}  // namespace HybridAStar
+#endif  // LOOKUPCACHE_H
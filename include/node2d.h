@@ -167,8 +167,8 @@ public:
     bool isOnGrid(const int width, const int height) const;
 
     // SUCCESSOR CREATION
-    /// Creates a successor on a eight-connected grid.
-    Node2D* createSuccessor(const int i);
+    /// Creates a successor on a eight-connected grid, written to the storage provided by the caller.
+    void createSuccessor(const int i, Node2D& successor);
 
     // CONSTANT VALUES
     /// Number of possible directions
@@ -6,29 +6,30 @@
 
 #include "constants.h"
 #include "helper.h"
+#include "plannerconfig.h"
 namespace HybridAStar
 {
 /*!
    \brief A three dimensional node class that is at the heart of the algorithm.
 
-   Each node has a unique configuration (x, y, theta) in the configuration space C.
+   Each node has a unique configuration (x, y, theta) in the configuration space C. The predecessor of a node is not
+   part of it, the search links the nodes in the Node3DStore by their positions.
 */
 class Node3D
 {
 public:
     /// The default constructor for 3D array initialization
-    Node3D() : Node3D(0, 0, 0, 0, 0, nullptr)
+    Node3D() : Node3D(0, 0, 0, 0, 0)
     {
     }
     /// Constructor for a node with the given arguments
-    Node3D(float x, float y, float t, float g, float h, const Node3D* pred, int prim = 0)
+    Node3D(float x, float y, float t, float g, float h, int prim = 0)
     {
         this->x    = x;
         this->y    = y;
         this->t    = t;
         this->g    = g;
         this->h    = h;
-        this->pred = pred;
         this->o    = false;
         this->c    = false;
         this->idx  = -1;
@@ -88,11 +89,6 @@ public:
     {
         return c;
     }
-    /// determine whether the node is open
-    const Node3D* getPred() const
-    {
-        return pred;
-    }
 
     // SETTER METHODS
     /// set the x position
@@ -120,10 +116,15 @@ public:
     {
         this->h = h;
     }
-    /// set and get the index of the node in the 3D grid
-    int setIdx(int width, int height)
+    /*!
+       \brief set and get the index of the node in the 3D grid, the heading is discretized by the fine headings of the
+       configuration near the goal, else by the coarse headings in the layers following the fine ones
+    */
+    int setIdx(int width, int height, const PlannerConfig& config, const Node3D& goal)
     {
-        this->idx = (int)(t / Constants::deltaHeadingRad) * width * height + (int)(y)*width + (int)(x);
+        int iT = config.isFine(x - goal.x, y - goal.y) ? (int)(t / config.deltaHeadingRad)
+                                                       : config.headings + (int)(t / config.coarseDeltaHeadingRad);
+        this->idx = iT * width * height + (int)(y)*width + (int)(x);
         return idx;
     }
     /// open the node
@@ -138,33 +139,37 @@ public:
         c = true;
         o = false;
     }
-    /// set a pointer to the predecessor of the node
-    void setPred(const Node3D* pred)
-    {
-        this->pred = pred;
-    }
 
     // UPDATE METHODS
     /// Updates the cost-so-far for the node x' coming from its predecessor. It also discovers the node.
-    void updateG();
+    void updateG(const Node3D& pred, const PlannerConfig& config);
 
     // CUSTOM OPERATORS
     /// Custom operator to compare nodes. Nodes are equal if their x and y position as well as heading is similar.
     bool operator==(const Node3D& rhs) const;
+    /// Compares the nodes as the operator, the headings are similar if they differ by at most deltaHeadingRad
+    bool isSimilar(const Node3D& rhs, float deltaHeadingRad) const;
 
     // RANGE CHECKING
     /// Determines whether it is appropriate to find a analytical solution.
     bool isInRange(const Node3D& goal) const;
 
     // GRID CHECKING
-    /// Validity check to test, whether the node is in the 3D array.
-    bool isOnGrid(const int width, const int height) const;
+    /// Validity check to test, whether the node is in the 3D array of the fine headings of the configuration.
+    bool isOnGrid(const int width, const int height, const PlannerConfig& config) const;
 
     // SUCCESSOR CREATION
-    /// Creates a successor in the continous space.
-    Node3D* createSuccessor(const int i);
-
-    Node3D* new_createSuccessor(const int i);
+    /// Creates a successor in the continous space, written to the storage provided by the caller.
+    void createSuccessor(const int i, Node3D& successor);
+    /// Creates a successor by the i-th motion primitive of the configuration from the cosine and sine of the heading of
+    /// the node, written to the storage provided by the caller.
+    void new_createSuccessor(const PlannerConfig& config, const int i, double cosT, double sinT,
+                             Node3D& successor) const
+    {
+        const PlannerConfig::Primitive& primitive = config.primitives[i];
+        successor = Node3D(x + primitive.dx * cosT - primitive.dy * sinT, y + primitive.dx * sinT + primitive.dy * cosT,
+                           Helper::normalizeHeadingRad(t + primitive.dt), g, 0, i);
+    }
 
     // CONSTANT VALUES
     /// Number of possible directions
@@ -195,18 +200,6 @@ private:
     bool c;
     /// the motion primitive of the node
     int prim;
-    /// the predecessor pointer
-    const Node3D* pred;
-
-public:
-    static int                succ_size_;
-    static int                forward_size_;
-    static int                backward_size_;
-    static std::vector<float> delta_x_;
-    static std::vector<float> delta_y_;
-    static std::vector<float> delta_t_;
-    static std::vector<float> step_size_;
-    static std::vector<float> delta_t_edg_;
 };
 }  // namespace HybridAStar
 #endif  // NODE3D_H
@@ -0,0 +1,198 @@
+#ifndef NODE3DSTORE_H
+#define NODE3DSTORE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "node3d.h"
+#include "searchnode.h"
+
+namespace HybridAStar
+{
+/*!
+   \brief A sparse store for the 3D nodes of the search, keyed by the index given by Node3D::setIdx.
+
+   It replaces the dense array of width * height * headings nodes. The keys are kept in an open addressing hash table
+   with linear probing, the nodes themselves are appended to two parallel arrays: the compact SearchNode records the
+   expansion loop works on, and the poses only needed to expand a node and to reconstruct the path. Nodes refer to
+   each other, and the open list refers to them, by their position in these arrays, so the arrays may grow and
+   relocate. The memory therefore scales with the number of cells the search touches and not with the size of the map.
+
+   Nodes that do not belong to a cell, like the poses of an analytical expansion, are appended without a key. The
+   path to any stored node can be followed through the positions of the predecessors until the next clear().
+
+   Every slot of the table carries the generation it was written in. Clearing the store only increments the
+   generation, the table and the chunks are kept and reused by the next search.
+*/
+class Node3DStore
+{
+public:
+    /// The default constructor
+    Node3DStore();
+
+    /// The pose of a stored node
+    struct Pose
+    {
+        /// the x position
+        float x;
+        /// the y position
+        float y;
+        /// the heading theta
+        float t;
+        /// the index of the node in the 3D grid
+        int idx;
+    };
+
+    /*!
+       \brief Returns the position of the node stored for the given index, inserting an unvisited node if there is none
+       yet. Positions are dense, starting at zero in the order of insertion.
+       \param idx the index of the node in the 3D grid
+       \return the position of the stored node
+    */
+    int position(int idx)
+    {
+        uint32_t i = hash(idx);
+
+        // probe until the key or a slot unused in this generation is found
+        for (;; i = (i + 1) & mask)
+        {
+            if (table[i].generation != generation)
+            {
+                return insert(idx, i);
+            }
+
+            if (table[i].key == idx)
+            {
+                return table[i].node;
+            }
+        }
+    }
+
+    /*!
+       \brief Looks up the node stored for the given index
+       \param idx the index of the node in the 3D grid
+       \return a pointer to the stored node, valid until the next insertion, or nullptr if the search has not touched it
+    */
+    const SearchNode* find(int idx) const
+    {
+        uint32_t i = hash(idx);
+
+        // probe until the key or a slot unused in this generation is found
+        for (;; i = (i + 1) & mask)
+        {
+            if (table[i].generation != generation)
+            {
+                return nullptr;
+            }
+
+            if (table[i].key == idx)
+            {
+                return &nodes[table[i].node];
+            }
+        }
+    }
+
+    /// Removes all nodes by starting a new generation, the allocated memory is kept for the next search
+    void clear();
+
+    /// get the number of stored nodes
+    int size() const
+    {
+        return count;
+    }
+    /// get the node at the given position
+    SearchNode& node(int i)
+    {
+        return nodes[i];
+    }
+    /// get the node at the given position
+    const SearchNode& node(int i) const
+    {
+        return nodes[i];
+    }
+    /// get the pose of the node at the given position
+    Pose& pose(int i)
+    {
+        return poses[i];
+    }
+    /// get the pose of the node at the given position
+    const Pose& pose(int i) const
+    {
+        return poses[i];
+    }
+
+    /*!
+       \brief Stores the node at the given position, splitting it into its record and its pose
+       \param i the position in the store
+       \param node the node, its index has to be set
+       \param pred the position of the predecessor in the store or SearchNode::none
+    */
+    void set(int i, const Node3D& node, uint32_t pred)
+    {
+        SearchNode& record = nodes[i];
+        record.setG(node.getG());
+        record.setH(node.getH());
+        record.setPred(pred);
+        record.setPrim(node.getPrim());
+        poses[i] = Pose{node.getX(), node.getY(), node.getT(), node.getIdx()};
+    }
+    /// Assembles the full node at the given position
+    Node3D get(int i) const
+    {
+        const SearchNode& record = nodes[i];
+        const Pose&       pose   = poses[i];
+        return Node3D(pose.x, pose.y, pose.t, record.getG(), record.getH(), record.getPrim());
+    }
+
+    /*!
+       \brief Appends a node that is not registered for its index and can not be found by it
+       \param node the node
+       \param pred the position of the predecessor in the store or SearchNode::none
+       \return the position of the appended node
+    */
+    int append(const Node3D& node, uint32_t pred);
+    /// Removes the nodes appended since the store had the given size, only valid for nodes appended without a key
+    void truncate(int size)
+    {
+        count = size;
+    }
+
+private:
+    /// An entry of the hash table mapping the index of a node to its position in the chunks
+    struct Slot
+    {
+        /// the index of the node in the 3D grid
+        int key;
+        /// the position of the node in the arrays
+        int node;
+        /// the generation the slot has been written in, slots of older generations are unused
+        uint32_t generation;
+    };
+
+    /// Fibonacci hashing of the index onto the table
+    uint32_t hash(int idx) const
+    {
+        return ((uint32_t)idx * 2654435769u) >> shift;
+    }
+    /// Appends a node for the index and registers it in the given slot, returns its position
+    int insert(int idx, uint32_t i);
+    /// Doubles the size of the hash table and reinserts all keys
+    void grow();
+
+    /// the hash table
+    std::vector<Slot> table;
+    /// the records of the nodes, kept across searches
+    std::vector<SearchNode> nodes;
+    /// the poses of the nodes, parallel to the records
+    std::vector<Pose> poses;
+    /// the number of slots minus one
+    uint32_t mask;
+    /// the shift reducing the hash to the size of the table
+    int shift;
+    /// the number of stored nodes
+    int count;
+    /// the current generation
+    uint32_t generation;
+};
+}  // namespace HybridAStar
+#endif  // NODE3DSTORE_H
@@ -15,9 +15,13 @@
 #include "constants.h"
 #include "dynamicvoronoi.h"
 #include "helper.h"
+#include "holonomicheuristic.h"
 #include "lookup.h"
+#include "lookupcache.h"
 #include "node3d.h"
 #include "path.h"
+#include "plannerconfig.h"
+#include "searchworkspace.h"
 #include "smoother.h"
 #include "visualize.h"
 
@@ -36,11 +40,24 @@ public:
     Planner();
 
     /*!
-       \brief Initializes the collision as well as heuristic lookup table
-       \todo probably removed
+       \brief Initializes the heuristic lookup table from the cache, rebuilding it in the background if the cache does
+       not match
     */
     void initializeLookups();
 
+    /*!
+       \brief Loads the configuration of the planner from the parameter file, the current configuration is kept if the
+       file can not be read. The searches started from now on use the new configuration.
+       \return whether the configuration was loaded
+    */
+    bool reloadConfig();
+
+    /*!
+       \brief Reloads the configuration if the parameter file changed, e.g. through a callback from a timer.
+       \param event the timer event
+    */
+    void checkConfig(const ros::TimerEvent& event);
+
     /*!
        \brief Sets the map e.g. through a callback from a subscriber listening to map updates.
        \param map the map or occupancy grid
@@ -91,6 +108,12 @@ private:
     CollisionDetection configurationSpace;
     /// The voronoi diagram
     DynamicVoronoi voronoiDiagram;
+    /// The buffers of the search, reused across plans
+    SearchWorkspace workspace;
+    /// The holonomic with obstacles heuristic, cached until the map or the goal changes
+    HolonomicHeuristic holonomic;
+    /// The cells whose occupancy changed with the last map update
+    std::vector<int> changedCells;
     /// A pointer to the grid the planner runs on
     nav_msgs::OccupancyGrid::Ptr grid;
     /// The start pose set through RViz
@@ -101,11 +124,16 @@ private:
     bool validStart = false;
     /// Flags for allowing the planner to plan
     bool validGoal = false;
-    /// A lookup table for configurations of the vehicle and their spatial occupancy enumeration
-    Constants::config collisionLookup[Constants::headings * Constants::positions];
-    /// A lookup of analytical solutions (Dubin's paths)
-    float* dubinsLookup =
-        new float[Constants::headings * Constants::headings * Constants::dubinsWidth * Constants::dubinsWidth];
+    /// A lookup of the lengths of analytical solutions (Dubin's or Reeds-Shepp paths), cached across restarts
+    LookupCache lookups;
+    /// The parameter file of the planner, reloaded whenever it changes
+    std::string configPath;
+    /// The configuration of the planner, replaced as a whole when the parameter file changes
+    std::shared_ptr<const PlannerConfig> config = std::make_shared<const PlannerConfig>();
+    /// A timer polling the parameter file for changes
+    ros::Timer configTimer;
+    /// The modification time of the parameter file the configuration was loaded from
+    time_t configModified = 0;
 };
 }  // namespace HybridAStar
 #endif  // PLANNER_H
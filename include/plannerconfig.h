@@ -0,0 +1,98 @@
+#ifndef PLANNERCONFIG_H
+#define PLANNERCONFIG_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace HybridAStar
+{
+/*!
+   \brief The parameters of the planner loaded from param.yaml, immutable once loaded.
+
+   The planner loads its configuration once and again only when the file changes, the search reads it through a const
+   reference, so planning does no file I/O and several planners can run with different configurations.
+
+   The motion primitives are given by their step size (in multiples of the arc of one heading step of the default
+   turning radius) and their change of heading in degrees, the first forwardSize drive forward, the others reverse.
+   They are compiled into the displacement in the frame of the start, read by the successor creation.
+
+   The heading of a node is discretized by the fine number of headings within the fine distance of the goal and by the
+   coarse number of headings beyond it. The two discretizations index separate spaces of nodes, the coarse one saves
+   expansions on the way, the fine one gives the precision to reach the goal. The collision lookup is built for the
+   fine number of headings.
+*/
+class PlannerConfig
+{
+public:
+    /// A motion primitive, the displacement in the frame of the start and the change of heading
+    struct Primitive
+    {
+        /// the displacement along the heading
+        float dx;
+        /// the displacement perpendicular to the heading
+        float dy;
+        /// the change of heading
+        float dt;
+    };
+
+    /// Constructs the configuration of the default param.yaml
+    PlannerConfig();
+
+    /*!
+       \brief Loads the configuration from the file
+       \param path the path of the YAML file
+       \return the configuration, it throws YAML::Exception if the file can not be read, lacks a parameter or has more
+       primitives than fit into a HeuristicBatch
+    */
+    static std::shared_ptr<const PlannerConfig> load(const std::string& path);
+
+    /// Determines whether the motion primitive drives in reverse
+    bool isReverse(int prim) const
+    {
+        return prim >= forwardSize;
+    }
+
+    /// Determines whether a node at the displacement from the goal is discretized by the fine headings
+    bool isFine(float dx, float dy) const
+    {
+        return coarseHeadings == headings || dx * dx + dy * dy <= fineDistance * fineDistance;
+    }
+
+    /// the number of motion primitives
+    int succSize;
+    /// the number of motion primitives driving forward
+    int forwardSize;
+    /// the number of motion primitives driving in reverse
+    int backwardSize;
+    /// the step size of every primitive as given, in multiples of Constants::primitiveStepUnit
+    std::vector<float> stepSize;
+    /// the step size of every primitive in cells
+    std::vector<float> stepLength;
+    /// the change of heading of every primitive in degrees
+    std::vector<float> deltaTEdg;
+    /// the displacement of every primitive along the heading of its start
+    std::vector<float> deltaX;
+    /// the displacement of every primitive perpendicular to the heading of its start
+    std::vector<float> deltaY;
+    /// the change of heading of every primitive in rad
+    std::vector<float> deltaT;
+    /// the primitives compiled into one contiguous table
+    std::vector<Primitive> primitives;
+    /// the number of headings near the goal, it sets the goal condition
+    int headings;
+    /// the number of headings far from the goal
+    int coarseHeadings;
+    /// the distance from the goal in cells within which the fine headings are used
+    float fineDistance;
+    /// the angle between two fine headings
+    float deltaHeadingRad;
+    /// the angle between two coarse headings
+    float coarseDeltaHeadingRad;
+
+private:
+    /// Computes the step lengths, the displacements, the table of the primitives and the headings from the given values
+    void compile();
+};
+}  // namespace HybridAStar
+#endif  // PLANNERCONFIG_H
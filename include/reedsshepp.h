@@ -0,0 +1,152 @@
+/*!
+  \file reedsshepp.h
+   \brief A Reeds-Shepp path class for finding analytical solutions to the problem of the shortest path of a vehicle
+   that can drive forwards and backwards.
+
+  The interface follows the one of dubins.h. The solver enumerates the path families of Reeds and Shepp, "Optimal paths
+  for a car that goes both forwards and backwards" (1990), using their time flip and reflection symmetries, with the
+  corrections to formulas 8.3 and 8.11 known from the implementation of the Open Motion Planning Library. It works on
+  the stack only, no memory is allocated.
+*/
+#ifndef REEDSSHEPP_H
+#define REEDSSHEPP_H
+
+// Error codes
+#define ERSOK (0)       // No error
+#define ERSBADRHO (1)   // the rho value is invalid
+#define ERSPARAM (2)    // Path parameterisitation error
+
+namespace HybridAStar
+{
+
+// The segment types of a path
+typedef enum
+{
+    RS_NOP      = 0,
+    RS_LEFT     = 1,
+    RS_STRAIGHT = 2,
+    RS_RIGHT    = 3
+} ReedsSheppSegmentType;
+
+// The number of path types
+#define RS_TYPES (18)
+
+// The maximum number of paths between two configurations, one for every formula and symmetry
+#define RS_CANDIDATES (44)
+
+// The segment types for each of the path types, unused trailing segments are RS_NOP
+extern const ReedsSheppSegmentType reeds_shepp_words[RS_TYPES][5];
+
+typedef struct
+{
+    double qi[3];     // the initial configuration
+    double param[5];  // the signed lengths of the five segments, negative for driving backwards
+    double rho;       // the turning radius
+    int    type;      // path type, an index into reeds_shepp_words
+} ReedsSheppPath;
+
+/**
+ * Callback function for path sampling
+ *
+ * @note the q parameter is a configuration
+ * @note the t parameter is the distance along the path
+ * @note the user_data parameter is forwarded from the caller
+ * @note return non-zero to denote sampling should be stopped
+ */
+typedef int (*ReedsSheppPathSamplingCallback)(double q[3], double t, void* user_data);
+
+/**
+ * Generate the shortest path from an initial configuration to a target configuration, with a specified minimum
+ * turning radius
+ *
+ * A configuration is (x, y, theta), where theta is in radians, with zero along the line y = 0, and counter-clockwise
+ * is positive
+ *
+ * @param q0    - a configuration specified as an array of x, y, theta
+ * @param q1    - a configuration specified as an array of x, y, theta
+ * @param rho   - turning radius of the vehicle
+ * @param path  - the resultant path
+ * @return      - non-zero on error
+ */
+int reeds_shepp_init(const double q0[3], const double q1[3], double rho, ReedsSheppPath* path);
+
+/**
+ * Generate all paths from an initial configuration to a target configuration, with a specified minimum turning radius,
+ * sorted by increasing length
+ *
+ * @param q0    - a configuration specified as an array of x, y, theta
+ * @param q1    - a configuration specified as an array of x, y, theta
+ * @param rho   - turning radius of the vehicle
+ * @param paths - the resultant paths, the shortest first
+ * @param count - the number of paths
+ * @return      - non-zero on error
+ */
+int reeds_shepp_init_all(const double q0[3], const double q1[3], double rho, ReedsSheppPath paths[RS_CANDIDATES],
+                         int* count);
+
+/**
+ * Calculate the length of the shortest path between two configurations without keeping the path
+ *
+ * @param q0    - a configuration specified as an array of x, y, theta
+ * @param q1    - a configuration specified as an array of x, y, theta
+ * @param rho   - turning radius of the vehicle
+ * @return      - the length of the path
+ */
+double reeds_shepp_distance(const double q0[3], const double q1[3], double rho);
+
+/**
+ * Calculate the length of an initialised path
+ *
+ * @param path - the path to find the length of
+ */
+double reeds_shepp_path_length(const ReedsSheppPath* path);
+
+/**
+ * Extract an integer that represents which path type was used
+ *
+ * @param path    - an initialised path
+ * @return        - an index into reeds_shepp_words (ie/ 0-17 inclusive)
+ */
+int reeds_shepp_path_type(const ReedsSheppPath* path);
+
+/**
+ * Calculate the configuration along the path, using the parameter t
+ *
+ * @param path - an initialised path
+ * @param t    - a length measure, where 0 <= t <= reeds_shepp_path_length(path)
+ * @param q    - the configuration result
+ * @returns    - non-zero if 't' is not in the correct range
+ */
+int reeds_shepp_path_sample(const ReedsSheppPath* path, double t, double q[3]);
+
+/**
+ * Determine whether the path is driven backwards at the parameter t
+ *
+ * @param path - an initialised path
+ * @param t    - a length measure, where 0 <= t <= reeds_shepp_path_length(path)
+ * @returns    - non-zero if the segment at 't' is driven backwards
+ */
+int reeds_shepp_path_reversing(const ReedsSheppPath* path, double t);
+
+/**
+ * Walk along the path at a fixed sampling interval, calling the
+ * callback function at each interval
+ *
+ * @param path      - the path to sample
+ * @param cb        - the callback function to call for each sample
+ * @param user_data - optional information to pass on to the callback
+ * @param stepSize  - the distance along the path for subsequent samples
+ */
+int reeds_shepp_path_sample_many(const ReedsSheppPath* path, ReedsSheppPathSamplingCallback cb, double stepSize,
+                                 void* user_data);
+
+/**
+ * Convenience function to identify the endpoint of a path
+ *
+ * @param path - an initialised path
+ * @param q    - the configuration result
+ */
+int reeds_shepp_path_endpoint(const ReedsSheppPath* path, double q[3]);
+
+}  // namespace HybridAStar
+#endif  // REEDSSHEPP_H
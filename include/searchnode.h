@@ -0,0 +1,114 @@
+#ifndef SEARCHNODE_H
+#define SEARCHNODE_H
+
+#include <cstdint>
+
+namespace HybridAStar
+{
+/*!
+   \brief The compact record of a 3D node in the Node3DStore, holding only the fields the expansion loop reads and
+   writes.
+
+   Four records fit into a cache line. The predecessor is the position of its record in the store rather than a
+   pointer, the open and closed flags and the motion primitive share one word. The pose, only needed to expand the
+   node and to reconstruct the path, is kept apart in Node3DStore::Pose.
+*/
+class SearchNode
+{
+public:
+    /// The predecessor of a node without one
+    static const uint32_t none = 0xffffffff;
+
+    /// The default constructor of an unvisited node
+    SearchNode() : g(0), h(0), pred(none), bits(0)
+    {
+    }
+
+    // GETTER METHODS
+    /// get the cost-so-far (real value)
+    float getG() const
+    {
+        return g;
+    }
+    /// get the cost-to-go (heuristic value)
+    float getH() const
+    {
+        return h;
+    }
+    /// get the total estimated cost
+    float getC() const
+    {
+        return g + h;
+    }
+    /// get the position of the predecessor in the store or SearchNode::none
+    uint32_t getPred() const
+    {
+        return pred;
+    }
+    /// get the number associated with the motion primitive of the node
+    int getPrim() const
+    {
+        return bits >> 2;
+    }
+    /// determine whether the node is open
+    bool isOpen() const
+    {
+        return bits & openBit;
+    }
+    /// determine whether the node is closed
+    bool isClosed() const
+    {
+        return bits & closedBit;
+    }
+
+    // SETTER METHODS
+    /// set the cost-so-far (real value)
+    void setG(float g)
+    {
+        this->g = g;
+    }
+    /// set the cost-to-go (heuristic value)
+    void setH(float h)
+    {
+        this->h = h;
+    }
+    /// set the position of the predecessor in the store
+    void setPred(uint32_t pred)
+    {
+        this->pred = pred;
+    }
+    /// set the motion primitive, keeping the open and closed flags
+    void setPrim(int prim)
+    {
+        bits = (uint32_t)prim << 2 | (bits & (openBit | closedBit));
+    }
+    /// open the node
+    void open()
+    {
+        bits = (bits & ~closedBit) | openBit;
+    }
+    /// close the node
+    void close()
+    {
+        bits = (bits & ~openBit) | closedBit;
+    }
+
+private:
+    /// The flag of open nodes
+    static const uint32_t openBit = 1;
+    /// The flag of closed nodes
+    static const uint32_t closedBit = 2;
+
+    /// the cost-so-far
+    float g;
+    /// the cost-to-go
+    float h;
+    /// the position of the predecessor in the store
+    uint32_t pred;
+    /// the open and closed flags in the lowest two bits, the motion primitive above
+    uint32_t bits;
+};
+
+static_assert(sizeof(SearchNode) == 16, "the record of a 3D node is expected to span 16 bytes");
+}  // namespace HybridAStar
+#endif  // SEARCHNODE_H
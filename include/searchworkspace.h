@@ -0,0 +1,38 @@
+#ifndef SEARCHWORKSPACE_H
+#define SEARCHWORKSPACE_H
+
+#include "bucketopenlist.h"
+#include "constants.h"
+#include "indexedheap.h"
+#include "node3dstore.h"
+
+namespace HybridAStar
+{
+/*!
+   \brief The buffers of the search, owned by the planner and reused across plan() calls.
+
+   Nothing is allocated or cleared in proportion to the map when a new query starts, only the cells the search visits
+   are touched.
+*/
+class SearchWorkspace
+{
+public:
+    /// Prepares the workspace for a new query
+    void prepare()
+    {
+        nodes3D.clear();
+        open.clear();
+        buckets.clear();
+    }
+
+    /// the sparse store of 3D nodes
+    Node3DStore nodes3D;
+    /// the open list of positions in the store
+    IndexedHeap open;
+    /// the quantized open list of positions in the store, used instead of the heap if bucketOpenList is set
+    BucketOpenList buckets;
+    /// whether the search uses the bucket open list, the default is Constants::bucketOpenList
+    bool bucketOpenList = Constants::bucketOpenList;
+};
+}  // namespace HybridAStar
+#endif  // SEARCHWORKSPACE_H
@@ -4,10 +4,13 @@
 #include <cmath>
 #include <vector>
 
+#include "collisiondetection.h"
 #include "constants.h"
 #include "dynamicvoronoi.h"
 #include "helper.h"
 #include "node3d.h"
+#include "node3dstore.h"
+#include "plannerconfig.h"
 #include "vector2d.h"
 namespace HybridAStar
 {
@@ -32,15 +35,21 @@ public:
        curvatureCost
        smoothnessCost
        voronoiCost
+
+       A node is only moved if the vehicle does not collide at its new position.
+       \param voronoi the Voronoi diagram of the map
+       \param configurationSpace the collision detection of the map
+       \param config the configuration of the planner, telling the reversing primitives apart
     */
-    void smoothPath(DynamicVoronoi& voronoi);
+    void smoothPath(DynamicVoronoi& voronoi, const CollisionDetection& configurationSpace, const PlannerConfig& config);
 
     /*!
-       \brief Given a node pointer the path to the root node will be traced recursively
-       \param node a 3D node, usually the goal node
-       \param i a parameter for counting the number of nodes
+       \brief Given the position of a stored node the path to the root node will be traced, the path starts with the
+       given node. The length of the chain is counted first, so the path is filled without reallocating.
+       \param nodes the store of the nodes of the search
+       \param position the position of a 3D node in the store, usually the goal node, or -1
     */
-    void tracePath(const Node3D* node, int i = 0, std::vector<Node3D> path = std::vector<Node3D>());
+    void tracePath(const Node3DStore& nodes, int position);
 
     /// returns the path of the smoother object
     const std::vector<Node3D>& getPath()
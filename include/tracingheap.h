@@ -0,0 +1,88 @@
+#ifndef TRACINGHEAP_H
+#define TRACINGHEAP_H
+
+#include <cstdint>
+#include <vector>
+
+#include "indexedheap.h"
+
+namespace HybridAStar
+{
+/*!
+   \brief The operations of a search on its open list in the order they happened, recorded to replay them on other
+   open lists, e.g. in benchmarks.
+
+   A push of an id that is already contained changes its key (decrease-key), a pop records the id and key it removed.
+*/
+struct OpenListTrace
+{
+    /// The operations on the open list
+    enum Operation : uint8_t
+    {
+        /// inserts the id or changes its key
+        push,
+        /// removes the id with the lowest key
+        pop
+    };
+
+    /// An operation and its arguments
+    struct Event
+    {
+        /// the operation
+        Operation operation;
+        /// the id
+        int id;
+        /// the key
+        float key;
+    };
+
+    /// the operations in the order they happened
+    std::vector<Event> events;
+};
+
+/*!
+   \brief An open list that forwards every operation to an IndexedHeap and records it in an OpenListTrace.
+*/
+class TracingHeap
+{
+public:
+    /*!
+       \brief Constructs the open list
+       \param heap the heap the operations are forwarded to
+       \param trace the trace the operations are appended to
+    */
+    TracingHeap(IndexedHeap& heap, OpenListTrace& trace) : heap(heap), trace(trace)
+    {
+    }
+
+    /// Determines whether the heap is empty
+    bool empty() const
+    {
+        return heap.empty();
+    }
+    /// get the id with the lowest key
+    int top() const
+    {
+        return heap.top();
+    }
+    /// Removes the id with the lowest key
+    void pop()
+    {
+        trace.events.push_back(OpenListTrace::Event{OpenListTrace::pop, heap.top(), heap.topKey()});
+        heap.pop();
+    }
+    /// Inserts the id or changes its key if it is already contained
+    void push(int id, float key)
+    {
+        trace.events.push_back(OpenListTrace::Event{OpenListTrace::push, id, key});
+        heap.push(id, key);
+    }
+
+private:
+    /// the heap the operations are forwarded to
+    IndexedHeap& heap;
+    /// the trace the operations are appended to
+    OpenListTrace& trace;
+};
+}  // namespace HybridAStar
+#endif  // TRACINGHEAP_H
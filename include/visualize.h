@@ -8,8 +8,11 @@
 #include <visualization_msgs/MarkerArray.h>
 
 #include "gradient.h"
+#include "holonomicheuristic.h"
 #include "node2d.h"
 #include "node3d.h"
+#include "plannerconfig.h"
+#include "searchworkspace.h"
 namespace HybridAStar
 {
 class Node3D;
@@ -55,12 +58,12 @@ public:
 
     // PUBLISH A SINGLE/ARRAY 3D NODE TO RViz
     /// Publishes a single node to RViz, usually the one currently being expanded
-    void publishNode3DPose(Node3D& node);
+    void publishNode3DPose(Node3D& node, const PlannerConfig& config);
     /// Publishes all expanded nodes to RViz
-    void publishNode3DPoses(Node3D& node);
+    void publishNode3DPoses(Node3D& node, const PlannerConfig& config);
     // PUBLISH THE COST FOR A 3D NODE TO RViz
     /// Publishes the minimum of the cost of all nodes in a 2D grid cell
-    void publishNode3DCosts(Node3D* nodes, int width, int height, int depth);
+    void publishNode3DCosts(const Node3DStore& nodes, int width, int height);
 
     // PUBLISH A SINGEL/ARRAY 2D NODE TO RViz
     /// Publishes a single node to RViz, usually the one currently being expanded
@@ -68,8 +71,8 @@ public:
     /// Publishes all expanded nodes to RViz
     void publishNode2DPoses(Node2D& node);
     // PUBLISH THE COST FOR A 2D NODE TO RViz
-    /// Publishes the minimum of the cost of all nodes in a 2D grid cell
-    void publishNode2DCosts(Node2D* nodes, int width, int height);
+    /// Publishes the cost-to-go of all cells from which the goal can be reached
+    void publishNode2DCosts(const HolonomicHeuristic& holonomic, int width, int height);
 
 private:
     /// A handle to the ROS node
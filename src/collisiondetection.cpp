@@ -1,38 +1,358 @@
 #include "collisiondetection.h"
 
+#include <algorithm>
+
 using namespace HybridAStar;
 
 CollisionDetection::CollisionDetection()
 {
-    this->grid = nullptr;
-    Lookup::collisionLookup(collisionLookup);
+    this->grid       = nullptr;
+    this->footprints = FootprintTable::shared(Constants::headings);
+
+    // the disks split the length of the vehicle into equal sections
+    for (int k = 0; k < Constants::diskCount; ++k)
+    {
+        diskOffset[k] = Constants::length / Constants::cellSize * ((k + 0.5f) / Constants::diskCount - 0.5f);
+    }
+}
+
+//###################################################
+//                                        UPDATE GRID
+//###################################################
+void CollisionDetection::updateGrid(nav_msgs::OccupancyGrid::Ptr map)
+{
+    grid   = map;
+    width  = map->info.width;
+    height = map->info.height;
+    stride = (width + 63) / 64 + 2;
+    occupancy.assign(stride * height, 0);
+    // the distances of the previous grid are invalid
+    clearance.clear();
+    distance.clear();
+
+    for (int y = 0; y < height; ++y)
+    {
+        uint64_t* row = &occupancy[y * stride];
+
+        for (int x = 0; x < width; ++x)
+        {
+            if (map->data[y * width + x])
+            {
+                row[(x + 64) >> 6] |= (uint64_t)1 << ((x + 64) & 63);
+            }
+        }
+    }
+
+    // _________
+    // THE TILES
+    // the cells of a tile beyond the grid are free, as is the padding of the bitmap
+    int tilesHigh = (height + tileSize - 1) / tileSize;
+    tilesWide     = (width + tileSize - 1) / tileSize;
+    tiles.assign(tilesWide * tilesHigh, empty);
+
+    for (int tY = 0; tY < tilesHigh; ++tY)
+    {
+        for (int tX = 0; tX < tilesWide; ++tX)
+        {
+            // the rows of the tile are bytes of the bitmap
+            int bit      = tX * tileSize + 64;
+            int occupied = 0;
+
+            for (int y = tY * tileSize; y < (tY + 1) * tileSize && y < height; ++y)
+            {
+                occupied += __builtin_popcountll((occupancy[y * stride + (bit >> 6)] >> (bit & 63)) & 0xff);
+            }
+
+            if (occupied == tileSize * tileSize)
+            {
+                tiles[tY * tilesWide + tX] = full;
+            }
+            else if (occupied > 0)
+            {
+                tiles[tY * tilesWide + tX] = mixed;
+            }
+        }
+    }
+}
+
+//###################################################
+//                                    UPDATE HEADINGS
+//###################################################
+void CollisionDetection::updateHeadings(int headings)
+{
+    if (footprints->getHeadings() == headings)
+    {
+        return;
+    }
+
+    footprints = FootprintTable::shared(headings);
+
+    // the swept footprints are indexed by the configurations of the footprints
+    if (sweeps)
+    {
+        sweeps = FootprintTable::shared(headings, sweepDx, sweepDy, sweepDt);
+    }
+}
+
+//###################################################
+//                                  UPDATE PRIMITIVES
+//###################################################
+void CollisionDetection::updatePrimitives(const std::vector<float>& dx, const std::vector<float>& dy,
+                                          const std::vector<float>& dt)
+{
+    if (!Constants::collisionSweep || (sweeps && dx == sweepDx && dy == sweepDy && dt == sweepDt))
+    {
+        return;
+    }
+
+    sweepDx    = dx;
+    sweepDy    = dy;
+    sweepDt    = dt;
+    primitives = dx.size();
+    sweeps     = FootprintTable::shared(footprints->getHeadings(), dx, dy, dt);
+}
+
+//###################################################
+//                                   UPDATE DISTANCES
+//###################################################
+void CollisionDetection::updateDistances(const DynamicVoronoi& voronoi)
+{
+    clearance.assign(width * height, band);
+    distance.assign(width * height, -1);
+
+    // the diagram does not cover the cells at the border of the grid, these are always tested
+    for (int y = 1; y < height - 1; ++y)
+    {
+        for (int x = 1; x < width - 1; ++x)
+        {
+            float d                 = voronoi.getDistance(x, y);
+            distance[y * width + x] = d;
+
+            if (d > Constants::collisionAcceptDistance)
+            {
+                clearance[y * width + x] = clear;
+            }
+            else if (d >= 0 && d < Constants::collisionRejectDistance)
+            {
+                clearance[y * width + x] = blocked;
+            }
+        }
+    }
 }
 
+//###################################################
+//                                 CONFIGURATION TEST
+//###################################################
 bool CollisionDetection::configurationTest(float x, float y, float t) const
 {
-    int X   = (int)x;
-    int Y   = (int)y;
-    int iX  = (int)((x - (long)x) * Constants::positionResolution);
-    iX      = iX > 0 ? iX : 0;
-    int iY  = (int)((y - (long)y) * Constants::positionResolution);
-    iY      = iY > 0 ? iY : 0;
-    int iT  = (int)(t / Constants::deltaHeadingRad);
-    int idx = iY * Constants::positionResolution * Constants::headings + iX * Constants::headings + iT;
-    int cX;
-    int cY;
+    int X;
+    int Y;
+    int idx = footprints->configuration(x, y, t, X, Y);
+
+    // accept or reject by the distance of the cell to the closest obstacle
+    if (Constants::collisionDistance && !clearance.empty() && X >= 0 && X < width && Y >= 0 && Y < height)
+    {
+        Clearance cell = clearance[Y * width + X];
+
+        if (cell != band)
+        {
+            return cell == clear;
+        }
+    }
+
+    return footprintTest(*footprints, idx, X, Y);
+}
+
+//###################################################
+//                                         BATCH TEST
+//###################################################
+bool CollisionDetection::batchTest(const float* x, const float* y, const float* t, int n) const
+{
+    if (model == disks)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            if (!diskTest(x[i], y[i], t[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
 
-    for (int i = 0; i < collisionLookup[idx].length; ++i)
+    // the poses whose footprint has to be tested
+    int pending[batchSize];
+    int count = 0;
+
+    // ____________________________
+    // ACCEPT OR REJECT BY DISTANCE
+    // every pose is classified before any footprint is tested, a blocked pose rejects the batch at once
+    for (int i = 0; i < n; ++i)
     {
-        cX = (X + collisionLookup[idx].pos[i].x);
-        cY = (Y + collisionLookup[idx].pos[i].y);
+        int X = (int)x[i];
+        int Y = (int)y[i];
 
-        // make sure the configuration coordinates are actually on the grid
-        if (cX >= 0 && (unsigned int)cX < grid->info.width && cY >= 0 && (unsigned int)cY < grid->info.height)
+        if (Constants::collisionDistance && !clearance.empty() && X >= 0 && X < width && Y >= 0 && Y < height)
         {
-            if (grid->data[cY * grid->info.width + cX])
+            Clearance cell = clearance[Y * width + X];
+
+            if (cell == blocked)
             {
                 return false;
             }
+
+            if (cell == clear)
+            {
+                continue;
+            }
+        }
+
+        pending[count++] = i;
+    }
+
+    // ______________
+    // THE FOOTPRINTS
+    for (int k = 0; k < count; ++k)
+    {
+        int X;
+        int Y;
+        int i   = pending[k];
+        int idx = footprints->configuration(x[i], y[i], t[i], X, Y);
+
+        if (!footprintTest(*footprints, idx, X, Y))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//###################################################
+//                                         SWEEP TEST
+//###################################################
+bool CollisionDetection::sweepTest(float x, float y, float t, int prim) const
+{
+    if (!Constants::collisionSweep || !sweeps)
+    {
+        return true;
+    }
+
+    int X;
+    int Y;
+    int idx = footprints->configuration(x, y, t, X, Y);
+
+    // accept if every pose along the primitive lies in a cell far enough from the closest obstacle, a cell within the
+    // reach of the primitive has its center at most a diagonal further away
+    if (Constants::collisionDistance && !distance.empty() && X > 0 && X < width - 1 && Y > 0 && Y < height - 1 &&
+        distance[Y * width + X] > Constants::collisionAcceptDistance + sweeps->getReach() + (float)M_SQRT2)
+    {
+        return true;
+    }
+
+    return footprintTest(*sweeps, idx * primitives + prim, X, Y);
+}
+
+//###################################################
+//                                     FOOTPRINT TEST
+//###################################################
+bool CollisionDetection::footprintTest(const FootprintTable& table, int idx, int X, int Y) const
+{
+    // ___________________________
+    // ACCEPT BY THE TILES COVERED
+    const FootprintTable::Bounds& bounds = table.getBounds(idx);
+    int                           tX0    = std::max(X + bounds.minX, 0) / tileSize;
+    int                           tY0    = std::max(Y + bounds.minY, 0) / tileSize;
+    int                           tX1    = std::min(X + bounds.maxX, width - 1) / tileSize;
+    int                           tY1    = std::min(Y + bounds.maxY, height - 1) / tileSize;
+    bool                          vacant = true;
+
+    for (int tY = tY0; tY <= tY1 && vacant; ++tY)
+    {
+        for (int tX = tX0; tX <= tX1 && vacant; ++tX)
+        {
+            vacant = tiles[tY * tilesWide + tX] == empty;
+        }
+    }
+
+    if (vacant)
+    {
+        return true;
+    }
+
+    // the rows of the footprint, a row spans at most 64 cells, see FootprintTable
+    for (const FootprintTable::Row* row = table.rowsBegin(idx); row != table.rowsEnd(idx); ++row)
+    {
+        int cY = Y + row->y;
+        int cX = X + row->x;
+
+        // make sure the row is actually on the grid, columns off the grid are covered by the padding
+        if (cY < 0 || cY >= height || cX < -64 || cX >= width)
+        {
+            continue;
+        }
+
+        // only rows reaching into tiles with obstacles are tested
+        const Tile* tileRow = &tiles[(cY / tileSize) * tilesWide];
+        int         tFirst  = std::max(cX, 0) / tileSize;
+        int         tLast   = std::max(std::min(cX + 63 - __builtin_clzll(row->mask), width - 1), 0) / tileSize;
+        bool        vacant  = true;
+
+        for (int tX = tFirst; tX <= tLast && vacant; ++tX)
+        {
+            vacant = tileRow[tX] == empty;
+        }
+
+        if (vacant)
+        {
+            continue;
+        }
+
+        // the 64 cells starting at the first cell of the row
+        int             bit   = cX + 64;
+        const uint64_t* words = &occupancy[cY * stride + (bit >> 6)];
+        uint64_t        cells = words[0] >> (bit & 63);
+
+        if (bit & 63)
+        {
+            cells |= words[1] << (64 - (bit & 63));
+        }
+
+        if (cells & row->mask)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//###################################################
+//                                          DISK TEST
+//###################################################
+bool CollisionDetection::diskTest(float x, float y, float t) const
+{
+    float cosT = std::cos(t);
+    float sinT = std::sin(t);
+
+    for (int k = 0; k < Constants::diskCount; ++k)
+    {
+        float dX = x + cosT * diskOffset[k];
+        float dY = y + sinT * diskOffset[k];
+        int   X  = (int)dX;
+        int   Y  = (int)dY;
+
+        // the distances do not cover the border of the grid
+        if (distance.empty() || dX < 1 || X >= width - 1 || dY < 1 || Y >= height - 1)
+        {
+            return configurationTest(x, y, t);
+        }
+
+        // the distance is measured between cells, the closest point of an obstacle cell may be a diagonal closer
+        if (distance[Y * width + X] - (float)M_SQRT2 <= Constants::diskRadius)
+        {
+            return false;
         }
     }
 
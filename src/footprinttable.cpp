@@ -0,0 +1,274 @@
+#include "footprinttable.h"
+
+#include <algorithm>
+#include <array>
+
+#include "helper.h"
+#include "lookup.h"
+
+using namespace HybridAStar;
+
+// the footprint of a row has to fit into a mask
+static_assert(Constants::bbSize <= 64, "the footprint has to fit into the 64 bit row masks");
+
+//###################################################
+//                                        CONSTRUCTOR
+//###################################################
+FootprintTable::FootprintTable(int headings) : headings(headings), deltaHeadingRad(2 * M_PI / (float)headings), reach(0)
+{
+    Lookup::collisionLookup(headings, cellStart, cells);
+
+    for (int idx = 0; idx < size(); ++idx)
+    {
+        // the center of the vehicle relative to its cell, as placed by the lookup
+        int   q  = idx / headings;
+        float cX = Constants::bbSize / 2.f + (float)(q % Constants::positionResolution) / Constants::positionResolution;
+        float cY = Constants::bbSize / 2.f + (float)(q / Constants::positionResolution) / Constants::positionResolution;
+        sortCells(idx, cX - (int)cX, cY - (int)cY);
+    }
+
+    buildRows();
+}
+
+//###################################################
+//                                    SWEPT FOOTPRINTS
+//###################################################
+FootprintTable::FootprintTable(const FootprintTable& footprints, const std::vector<float>& dx,
+                               const std::vector<float>& dy, const std::vector<float>& dt)
+    : headings(footprints.headings), deltaHeadingRad(footprints.deltaHeadingRad), reach(0)
+{
+    const int   primitives = dx.size();
+    const int   positions  = Constants::positions;
+    const float resolution = Constants::positionResolution;
+    // the sweeps of all headings and primitives of every position within the cell, built in parallel
+    std::vector<std::vector<int>>               ends(positions);
+    std::vector<std::vector<Constants::relPos>> positionCells(positions);
+
+    for (int prim = 0; prim < primitives; ++prim)
+    {
+        reach = std::max(reach, std::sqrt(dx[prim] * dx[prim] + dy[prim] * dy[prim]));
+    }
+
+    Lookup::parallelFor(positions, [&](int q) {
+        // the start position relative to its cell
+        float                           x     = (q % Constants::positionResolution) / resolution;
+        float                           y     = (q / Constants::positionResolution) / resolution;
+        std::vector<Constants::relPos>& sweep = positionCells[q];
+        // the cells and the configurations of the sampled poses, each footprint is added once
+        std::vector<std::array<int, 3>> poses;
+
+        for (int iT = 0; iT < headings; ++iT)
+        {
+            float t = iT * deltaHeadingRad;
+
+            for (int prim = 0; prim < primitives; ++prim)
+            {
+                float chord = std::sqrt(dx[prim] * dx[prim] + dy[prim] * dy[prim]);
+                // the farthest a cell of the footprint moves along the primitive and within the heading of the start
+                float travel   = chord + std::abs(dt[prim]) * Constants::bbSize / 2;
+                float rotation = deltaHeadingRad * (chord + Constants::bbSize / 2);
+                int   samples  = std::max(1, (int)std::ceil(travel / Constants::sweepResolution));
+                int   turns    = std::max(1, (int)std::ceil(rotation / Constants::sweepResolution));
+                poses.clear();
+
+                // ____________________
+                // THE CONTINUOUS START
+                // the start lies anywhere within the discrete position and heading, the corners of the position and
+                // the headings in steps of the resolution cover it
+                for (int corner = 0; corner < 4; ++corner)
+                {
+                    for (int r = 0; r <= turns; ++r)
+                    {
+                        float x0 = x + (corner & 1) / resolution;
+                        float y0 = y + (corner >> 1) / resolution;
+                        float t0 = t + deltaHeadingRad * r / turns;
+
+                        // _________________
+                        // THE SAMPLED POSES
+                        // along the circular arc of the primitive, whose heading changes evenly from the start to the
+                        // end, both of which are tested on their own
+                        for (int k = 1; k < samples; ++k)
+                        {
+                            float f = (float)k / samples;
+                            // the chord to the pose is shorter than the chord of the entire arc by sin(f turn) /
+                            // sin(turn) and rotated against it by (f - 1) turn, turn being half the change of heading
+                            float turn   = dt[prim] / 2;
+                            float length = std::abs(turn) < 1e-6f ? f : std::sin(f * turn) / std::sin(turn);
+                            float angle  = t0 + (f - 1) * turn;
+                            float cX     = length * dx[prim];
+                            float cY     = length * dy[prim];
+                            float sX     = x0 + cX * std::cos(angle) - cY * std::sin(angle);
+                            float sY     = y0 + cX * std::sin(angle) + cY * std::cos(angle);
+                            float sT     = Helper::normalizeHeadingRad(t0 + f * dt[prim]);
+                            int   X      = (int)std::floor(sX);
+                            int   Y      = (int)std::floor(sY);
+                            int   iX     = std::min((int)((sX - X) * resolution), Constants::positionResolution - 1);
+                            int   iY     = std::min((int)((sY - Y) * resolution), Constants::positionResolution - 1);
+                            poses.push_back({X, Y,
+                                             (iY * Constants::positionResolution + iX) * headings +
+                                                 (int)(sT / deltaHeadingRad) % headings});
+                        }
+                    }
+                }
+
+                std::sort(poses.begin(), poses.end());
+                poses.erase(std::unique(poses.begin(), poses.end()), poses.end());
+                int first = sweep.size();
+
+                for (const std::array<int, 3>& pose : poses)
+                {
+                    for (const Constants::relPos* cell = footprints.cellsBegin(pose[2]);
+                         cell != footprints.cellsEnd(pose[2]); ++cell)
+                    {
+                        sweep.push_back(Constants::relPos{(int16_t)(cell->x + pose[0]), (int16_t)(cell->y + pose[1])});
+                    }
+                }
+
+                // the union of the footprints
+                std::sort(sweep.begin() + first, sweep.end(),
+                          [](const Constants::relPos& a, const Constants::relPos& b) {
+                              return a.y < b.y || (a.y == b.y && a.x < b.x);
+                          });
+                sweep.erase(std::unique(sweep.begin() + first, sweep.end(),
+                                        [](const Constants::relPos& a, const Constants::relPos& b) {
+                                            return a.x == b.x && a.y == b.y;
+                                        }),
+                            sweep.end());
+                ends[q].push_back(sweep.size());
+            }
+        }
+    });
+
+    // ___________
+    // CONCATENATE
+    cellStart.assign(1, 0);
+
+    for (int q = 0; q < positions; ++q)
+    {
+        for (int end : ends[q])
+        {
+            cellStart.push_back(cells.size() + end);
+        }
+
+        cells.insert(cells.end(), positionCells[q].begin(), positionCells[q].end());
+    }
+
+    for (int idx = 0; idx < size(); ++idx)
+    {
+        int q = idx / (headings * primitives);
+        sortCells(idx, (q % Constants::positionResolution) / resolution,
+                  (q / Constants::positionResolution) / resolution);
+    }
+
+    buildRows();
+}
+
+//###################################################
+//                                         SORT CELLS
+//###################################################
+void FootprintTable::sortCells(int idx, float cX, float cY)
+{
+    // the outermost cells first, by the distance of the cell centers
+    std::stable_sort(cells.begin() + cellStart[idx], cells.begin() + cellStart[idx + 1],
+                     [cX, cY](const Constants::relPos& a, const Constants::relPos& b) {
+                         float aX = a.x + 0.5f - cX;
+                         float aY = a.y + 0.5f - cY;
+                         float bX = b.x + 0.5f - cX;
+                         float bY = b.y + 0.5f - cY;
+                         return aX * aX + aY * aY > bX * bX + bY * bY;
+                     });
+}
+
+//###################################################
+//                                         BUILD ROWS
+//###################################################
+void FootprintTable::buildRows()
+{
+    const int configurations = size();
+    rowStart.resize(configurations + 1);
+    bounds.resize(configurations);
+    rows.clear();
+
+    for (int idx = 0; idx < configurations; ++idx)
+    {
+        rowStart[idx] = rows.size();
+        bounds[idx]   = Bounds{INT16_MAX, INT16_MAX, INT16_MIN, INT16_MIN};
+
+        for (const Constants::relPos* cell = cellsBegin(idx); cell != cellsEnd(idx); ++cell)
+        {
+            bounds[idx].minX = std::min<int>(bounds[idx].minX, cell->x);
+            bounds[idx].minY = std::min<int>(bounds[idx].minY, cell->y);
+            bounds[idx].maxX = std::max<int>(bounds[idx].maxX, cell->x);
+            bounds[idx].maxY = std::max<int>(bounds[idx].maxY, cell->y);
+
+            // the row of the cell if it spans less than 64 cells with it, rows are ordered by their outermost cell
+            Row* row = nullptr;
+
+            for (int r = rowStart[idx]; r < (int)rows.size(); ++r)
+            {
+                int first = std::min<int>(rows[r].x, cell->x);
+                int last  = std::max<int>(rows[r].x + 63 - __builtin_clzll(rows[r].mask), cell->x);
+
+                if (rows[r].y == cell->y && last - first < 64)
+                {
+                    row = &rows[r];
+                }
+            }
+
+            if (row == nullptr)
+            {
+                rows.push_back(Row{cell->y, cell->x, 0});
+                row = &rows.back();
+            }
+
+            // rebase the mask if the cell lies left of the first cell so far
+            if (cell->x < row->x)
+            {
+                row->mask <<= row->x - cell->x;
+                row->x = cell->x;
+            }
+
+            row->mask |= (uint64_t)1 << (cell->x - row->x);
+        }
+    }
+
+    rowStart[configurations] = rows.size();
+}
+
+//###################################################
+//                                       SHARED TABLE
+//###################################################
+std::shared_ptr<const FootprintTable> FootprintTable::shared(int headings)
+{
+    // built once per number of headings, the tables are kept for the lifetime of the process
+    static std::mutex                                           mutex;
+    static std::map<int, std::shared_ptr<const FootprintTable>> tables;
+    std::lock_guard<std::mutex>                                 lock(mutex);
+    std::shared_ptr<const FootprintTable>&                      table = tables[headings];
+
+    if (!table)
+    {
+        table = std::make_shared<const FootprintTable>(headings);
+    }
+
+    return table;
+}
+
+std::shared_ptr<const FootprintTable> FootprintTable::shared(int headings, const std::vector<float>& dx,
+                                                             const std::vector<float>& dy,
+                                                             const std::vector<float>& dt)
+{
+    // built once per number of headings and primitives, the tables are kept for the lifetime of the process
+    typedef std::tuple<int, std::vector<float>, std::vector<float>, std::vector<float>> Key;
+    static std::mutex                                            mutex;
+    static std::map<Key, std::shared_ptr<const FootprintTable>> sweeps;
+    std::lock_guard<std::mutex>                                  lock(mutex);
+    std::shared_ptr<const FootprintTable>&                       table = sweeps[Key(headings, dx, dy, dt)];
+
+    if (!table)
+    {
+        table = std::make_shared<const FootprintTable>(*shared(headings), dx, dy, dt);
+    }
+
+    return table;
+}
@@ -0,0 +1,320 @@
+#include "heuristic.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+#include "lookup.h"
+
+using namespace HybridAStar;
+
+namespace
+{
+// whether the non-holonomic heuristic is Reeds-Shepp, folded on both axes, else Dubin's
+const bool reedsShepp = Constants::reverse && !Constants::dubins;
+// whether any non-holonomic heuristic is active
+const bool nonHolonomic = Constants::reverse || Constants::dubins;
+
+/// The intermediate results of the kernels per lane
+struct Lanes
+{
+    /// the pose of the goal relative to the pose of the lane
+    alignas(32) float x[HeuristicBatch::capacity];
+    alignas(32) float y[HeuristicBatch::capacity];
+    alignas(32) float t[HeuristicBatch::capacity];
+    /// the cosine and sine of the heading of the lane
+    alignas(32) float cos[HeuristicBatch::capacity];
+    alignas(32) float sin[HeuristicBatch::capacity];
+    /// the holonomic with obstacles term
+    alignas(32) float twoD[HeuristicBatch::capacity];
+    /// the entry of the lookup or -1 if the relative pose is outside of it
+    alignas(32) int index[HeuristicBatch::capacity];
+};
+
+/// The constants of the goal shared by all lanes
+struct Goal
+{
+    float x;
+    float y;
+    float t;
+    /// the position of the goal within its cell
+    float fracX;
+    float fracY;
+};
+
+//###################################################
+//                                      SCALAR KERNEL
+//###################################################
+// computes the lanes [from, to), see Lookup::dubinsLookupIndex for the layout of the lookup
+inline void scalarKernel(const HeuristicBatch& batch, const Goal& goal, const HolonomicHeuristic& holonomic,
+                         Lanes& lanes, int from, int to)
+{
+    const float* field = holonomic.getCosts();
+
+    for (int i = from; i < to; ++i)
+    {
+        float dx = goal.x - batch.x[i];
+        float dy = goal.y - batch.y[i];
+        float x  = lanes.cos[i] * dx + lanes.sin[i] * dy;
+        float y  = -lanes.sin[i] * dx + lanes.cos[i] * dy;
+        float t  = goal.t - batch.t[i];
+
+        lanes.x[i]     = x;
+        lanes.y[i]     = y;
+        lanes.t[i]     = t;
+        lanes.index[i] = Constants::dubinsLookup ? Lookup::dubinsLookupIndex(x, y, t) : -1;
+
+        float fx       = (batch.x[i] - (long)batch.x[i]) - goal.fracX;
+        float fy       = (batch.y[i] - (long)batch.y[i]) - goal.fracY;
+        lanes.twoD[i]  = field[(int)batch.y[i] * holonomic.getWidth() + (int)batch.x[i]] - std::sqrt(fx * fx + fy * fy);
+    }
+}
+
+#if defined(__AVX2__)
+//###################################################
+//                                        AVX2 KERNEL
+//###################################################
+// computes eight lanes starting at i
+inline void vectorKernel(const HeuristicBatch& batch, const Goal& goal, const HolonomicHeuristic& holonomic,
+                         Lanes& lanes, int i)
+{
+    const __m256 zero   = _mm256_setzero_ps();
+    const __m256 half   = _mm256_set1_ps(0.5f);
+    const __m256 sign   = _mm256_set1_ps(-0.f);
+    const __m256 twoPi  = _mm256_set1_ps(2 * (float)M_PI);
+    const __m256i steps = _mm256_set1_epi32(Constants::dubinsLookupSteps);
+
+    __m256 x  = _mm256_load_ps(batch.x + i);
+    __m256 y  = _mm256_load_ps(batch.y + i);
+    __m256 c  = _mm256_load_ps(lanes.cos + i);
+    __m256 s  = _mm256_load_ps(lanes.sin + i);
+    __m256 dx = _mm256_sub_ps(_mm256_set1_ps(goal.x), x);
+    __m256 dy = _mm256_sub_ps(_mm256_set1_ps(goal.y), y);
+
+    // the pose of the goal relative to the lane
+    __m256 rx = _mm256_add_ps(_mm256_mul_ps(c, dx), _mm256_mul_ps(s, dy));
+    __m256 ry = _mm256_sub_ps(_mm256_mul_ps(c, dy), _mm256_mul_ps(s, dx));
+    __m256 rt = _mm256_sub_ps(_mm256_set1_ps(goal.t), _mm256_load_ps(batch.t + i));
+    _mm256_store_ps(lanes.x + i, rx);
+    _mm256_store_ps(lanes.y + i, ry);
+    _mm256_store_ps(lanes.t + i, rt);
+
+    if (Constants::dubinsLookup)
+    {
+        // mirror on the x axis
+        __m256 mask = _mm256_cmp_ps(ry, zero, _CMP_LT_OQ);
+        ry          = _mm256_andnot_ps(sign, ry);
+        rt          = _mm256_xor_ps(rt, _mm256_and_ps(mask, sign));
+
+        // mirror on the y axis
+        if (reedsShepp)
+        {
+            mask = _mm256_cmp_ps(rx, zero, _CMP_LT_OQ);
+            rx   = _mm256_andnot_ps(sign, rx);
+            rt   = _mm256_xor_ps(rt, _mm256_and_ps(mask, sign));
+        }
+
+        const __m256 resolution = _mm256_set1_ps(Constants::positionResolution);
+        const __m256 limit      = _mm256_set1_ps(Constants::dubinsLookupSteps);
+        __m256       fX         = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(rx, resolution), half));
+        __m256       fY         = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(ry, resolution), half));
+
+        // outside of the lookup, compared before the conversion so that far poses can not overflow
+        __m256 outside = _mm256_or_ps(_mm256_cmp_ps(fY, limit, _CMP_GT_OQ), _mm256_cmp_ps(fX, limit, _CMP_GT_OQ));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(fX, _mm256_xor_ps(limit, sign), _CMP_LT_OQ));
+
+        __m256i X = _mm256_cvttps_epi32(fX);
+        __m256i Y = _mm256_cvttps_epi32(fY);
+
+        if (!reedsShepp)
+        {
+            X = _mm256_add_epi32(X, steps);
+        }
+
+        // the nearest heading
+        rt         = _mm256_add_ps(rt, _mm256_and_ps(_mm256_cmp_ps(rt, zero, _CMP_LT_OQ), twoPi));
+        __m256i H  = _mm256_cvttps_epi32(_mm256_floor_ps(
+            _mm256_add_ps(_mm256_div_ps(rt, _mm256_set1_ps(Constants::deltaHeadingRad)), half)));
+        __m256i hs = _mm256_set1_epi32(Constants::headings);
+        H          = _mm256_sub_epi32(H, _mm256_andnot_si256(_mm256_cmpgt_epi32(hs, H), hs));
+
+        __m256i index = _mm256_mullo_epi32(
+            _mm256_add_epi32(_mm256_mullo_epi32(X, _mm256_add_epi32(steps, _mm256_set1_epi32(1))), Y), hs);
+        index = _mm256_or_si256(_mm256_add_epi32(index, H), _mm256_castps_si256(outside));
+        _mm256_store_si256((__m256i*)(lanes.index + i), index);
+    }
+    else
+    {
+        _mm256_store_si256((__m256i*)(lanes.index + i), _mm256_set1_epi32(-1));
+    }
+
+    // the holonomic with obstacles term less the offset within the cell
+    __m256  cellX = _mm256_round_ps(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m256  cellY = _mm256_round_ps(y, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m256  fx    = _mm256_sub_ps(_mm256_sub_ps(x, cellX), _mm256_set1_ps(goal.fracX));
+    __m256  fy    = _mm256_sub_ps(_mm256_sub_ps(y, cellY), _mm256_set1_ps(goal.fracY));
+    __m256  off   = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(fx, fx), _mm256_mul_ps(fy, fy)));
+    __m256i cell  = _mm256_add_epi32(
+        _mm256_mullo_epi32(_mm256_cvttps_epi32(cellY), _mm256_set1_epi32(holonomic.getWidth())),
+        _mm256_cvttps_epi32(cellX));
+    __m256 cost = _mm256_i32gather_ps(holonomic.getCosts(), cell, 4);
+    _mm256_store_ps(lanes.twoD + i, _mm256_sub_ps(cost, off));
+}
+
+// the number of lanes of the vector kernel
+const int vectorWidth = 8;
+#elif defined(__SSE2__)
+//###################################################
+//                                        SSE2 KERNEL
+//###################################################
+// rounds to the nearest integer with halves rounded up, SSE2 lacks a floor instruction
+inline __m128i roundHalfUp(__m128 v)
+{
+    v            = _mm_add_ps(v, _mm_set1_ps(0.5f));
+    __m128i i    = _mm_cvttps_epi32(v);
+    __m128  down = _mm_cmpgt_ps(_mm_cvtepi32_ps(i), v);
+    return _mm_add_epi32(i, _mm_castps_si128(down));
+}
+
+// computes four lanes starting at i
+inline void vectorKernel(const HeuristicBatch& batch, const Goal& goal, const HolonomicHeuristic& holonomic,
+                         Lanes& lanes, int i)
+{
+    const __m128 zero  = _mm_setzero_ps();
+    const __m128 sign  = _mm_set1_ps(-0.f);
+    const __m128 twoPi = _mm_set1_ps(2 * (float)M_PI);
+    const int    steps = Constants::dubinsLookupSteps;
+
+    __m128 x  = _mm_load_ps(batch.x + i);
+    __m128 y  = _mm_load_ps(batch.y + i);
+    __m128 c  = _mm_load_ps(lanes.cos + i);
+    __m128 s  = _mm_load_ps(lanes.sin + i);
+    __m128 dx = _mm_sub_ps(_mm_set1_ps(goal.x), x);
+    __m128 dy = _mm_sub_ps(_mm_set1_ps(goal.y), y);
+
+    // the pose of the goal relative to the lane
+    __m128 rx = _mm_add_ps(_mm_mul_ps(c, dx), _mm_mul_ps(s, dy));
+    __m128 ry = _mm_sub_ps(_mm_mul_ps(c, dy), _mm_mul_ps(s, dx));
+    __m128 rt = _mm_sub_ps(_mm_set1_ps(goal.t), _mm_load_ps(batch.t + i));
+    _mm_store_ps(lanes.x + i, rx);
+    _mm_store_ps(lanes.y + i, ry);
+    _mm_store_ps(lanes.t + i, rt);
+
+    if (Constants::dubinsLookup)
+    {
+        // mirror on the x axis
+        __m128 mask = _mm_cmplt_ps(ry, zero);
+        ry          = _mm_andnot_ps(sign, ry);
+        rt          = _mm_xor_ps(rt, _mm_and_ps(mask, sign));
+
+        // mirror on the y axis
+        if (reedsShepp)
+        {
+            mask = _mm_cmplt_ps(rx, zero);
+            rx   = _mm_andnot_ps(sign, rx);
+            rt   = _mm_xor_ps(rt, _mm_and_ps(mask, sign));
+        }
+
+        const __m128 resolution = _mm_set1_ps(Constants::positionResolution);
+        alignas(16) int X[4], Y[4], H[4];
+        _mm_store_si128((__m128i*)X, roundHalfUp(_mm_mul_ps(rx, resolution)));
+        _mm_store_si128((__m128i*)Y, roundHalfUp(_mm_mul_ps(ry, resolution)));
+        rt = _mm_add_ps(rt, _mm_and_ps(_mm_cmplt_ps(rt, zero), twoPi));
+        _mm_store_si128((__m128i*)H, roundHalfUp(_mm_div_ps(rt, _mm_set1_ps(Constants::deltaHeadingRad))));
+
+        // SSE2 lacks a 32 bit multiplication, the indices are assembled per lane
+        for (int j = 0; j < 4; ++j)
+        {
+            int Xj = reedsShepp ? X[j] : X[j] + steps;
+            int Hj = H[j] == Constants::headings ? 0 : H[j];
+
+            lanes.index[i + j] = Y[j] > steps || X[j] > steps || X[j] < -steps
+                                     ? -1
+                                     : (Xj * (steps + 1) + Y[j]) * Constants::headings + Hj;
+        }
+    }
+    else
+    {
+        _mm_store_si128((__m128i*)(lanes.index + i), _mm_set1_epi32(-1));
+    }
+
+    // the holonomic with obstacles term less the offset within the cell
+    __m128i cellX = _mm_cvttps_epi32(x);
+    __m128i cellY = _mm_cvttps_epi32(y);
+    __m128  fx    = _mm_sub_ps(_mm_sub_ps(x, _mm_cvtepi32_ps(cellX)), _mm_set1_ps(goal.fracX));
+    __m128  fy    = _mm_sub_ps(_mm_sub_ps(y, _mm_cvtepi32_ps(cellY)), _mm_set1_ps(goal.fracY));
+    _mm_store_ps(lanes.twoD + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(fx, fx), _mm_mul_ps(fy, fy))));
+
+    const float* field = holonomic.getCosts();
+
+    for (int j = 0; j < 4; ++j)
+    {
+        int cell = (int)batch.y[i + j] * holonomic.getWidth() + (int)batch.x[i + j];
+        lanes.twoD[i + j] = field[cell] - lanes.twoD[i + j];
+    }
+}
+
+// the number of lanes of the vector kernel
+const int vectorWidth = 4;
+#endif
+}  // namespace
+
+//###################################################
+//                                           EVALUATE
+//###################################################
+void Heuristic::evaluate(HeuristicBatch& batch, const Node3D& goal, const HolonomicHeuristic& holonomic,
+                         const float* dubinsLookup)
+{
+    Lanes lanes;
+    Goal  g = {goal.getX(), goal.getY(), goal.getT(), goal.getX() - (long)goal.getX(),
+               goal.getY() - (long)goal.getY()};
+
+    for (int i = 0; i < batch.size; ++i)
+    {
+        lanes.cos[i] = std::cos(batch.t[i]);
+        lanes.sin[i] = std::sin(batch.t[i]);
+    }
+
+    int i = 0;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    // pad the last vector with copies of the first pose, so that every lane reads a valid cell
+    int padded = (batch.size + vectorWidth - 1) / vectorWidth * vectorWidth;
+
+    for (int j = batch.size; j < padded; ++j)
+    {
+        batch.x[j]   = batch.x[0];
+        batch.y[j]   = batch.y[0];
+        batch.t[j]   = batch.t[0];
+        lanes.cos[j] = lanes.cos[0];
+        lanes.sin[j] = lanes.sin[0];
+    }
+
+    for (; i < batch.size; i += vectorWidth)
+    {
+        vectorKernel(batch, g, holonomic, lanes, i);
+    }
+#endif
+
+    scalarKernel(batch, g, holonomic, lanes, i, batch.size);
+
+    // look the non-holonomic term up, the poses outside of the lookup are computed analytically
+    for (i = 0; i < batch.size; ++i)
+    {
+        float nonHolonomicCost = 0;
+        float twoDCost         = Constants::twoD ? lanes.twoD[i] : 0;
+
+        if (nonHolonomic)
+        {
+            nonHolonomicCost = lanes.index[i] >= 0 && dubinsLookup != nullptr
+                                   ? dubinsLookup[lanes.index[i]]
+                                   : Lookup::analyticalLength(lanes.x[i], lanes.y[i], lanes.t[i]);
+        }
+
+        // the maximum of the heuristics, making the heuristic admissable
+        batch.h[i] = std::max(nonHolonomicCost, std::max(0.f, twoDCost));
+    }
+}
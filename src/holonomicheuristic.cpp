@@ -0,0 +1,211 @@
+#include "holonomicheuristic.h"
+
+#include <algorithm>
+
+using namespace HybridAStar;
+
+constexpr float HolonomicHeuristic::unreachable;
+
+// the movement cost of Node2D for the i-th direction, either 1 or sqrt(2)
+static inline float movementCost(int i)
+{
+    return Node2D::dx[i] != 0 && Node2D::dy[i] != 0 ? (float)M_SQRT2 : 1.f;
+}
+
+//###################################################
+//                                            SET MAP
+//###################################################
+void HolonomicHeuristic::setMap(const nav_msgs::OccupancyGrid::Ptr& map)
+{
+    grid   = map;
+    width  = map->info.width;
+    height = map->info.height;
+    valid  = false;
+    pending.clear();
+}
+
+//###################################################
+//                                         UPDATE MAP
+//###################################################
+void HolonomicHeuristic::updateMap(const nav_msgs::OccupancyGrid::Ptr& map, const std::vector<int>& changed)
+{
+    grid = map;
+
+    // without a field there is nothing to repair
+    if (!valid)
+    {
+        return;
+    }
+
+    // a large change is cheaper to sweep from scratch
+    if (pending.size() + changed.size() > cost.size() / 8)
+    {
+        valid = false;
+        pending.clear();
+        return;
+    }
+
+    pending.insert(pending.end(), changed.begin(), changed.end());
+}
+
+//###################################################
+//                                           SET GOAL
+//###################################################
+void HolonomicHeuristic::setGoal(int x, int y)
+{
+    if (valid && x == goalX && y == goalY)
+    {
+        repair();
+        return;
+    }
+
+    goalX = x;
+    goalY = y;
+    sweep();
+    valid = true;
+}
+
+//###################################################
+//                                    DIJKSTRA SWEEP
+//###################################################
+void HolonomicHeuristic::sweep()
+{
+    cost.assign(width * height, unreachable);
+    open.clear();
+    open.reserve(width * height);
+    pending.clear();
+
+    if (goalX >= 0 && goalX < width && goalY >= 0 && goalY < height)
+    {
+        // the goal is pushed without a collision check like the start of a 2D search
+        cost[goalY * width + goalX] = 0;
+        open.push(goalY * width + goalX, 0);
+    }
+
+    while (!open.empty())
+    {
+        // pop the cell with the lowest cost
+        int   idx = open.top();
+        float g   = open.topKey();
+        open.pop();
+
+        int x = idx % width;
+        int y = idx / width;
+
+        // relax the eight-connected neighbors
+        for (int i = 0; i < Node2D::dir; ++i)
+        {
+            int xSucc = x + Node2D::dx[i];
+            int ySucc = y + Node2D::dy[i];
+
+            // ensure successor is on grid and not blocked by an obstacle
+            if (xSucc < 0 || xSucc >= width || ySucc < 0 || ySucc >= height || isBlocked(ySucc * width + xSucc))
+            {
+                continue;
+            }
+
+            float newG = g + movementCost(i);
+
+            // decrease the key of the cell if it has been reached cheaper
+            if (newG < cost[ySucc * width + xSucc])
+            {
+                cost[ySucc * width + xSucc] = newG;
+                open.push(ySucc * width + xSucc, newG);
+            }
+        }
+    }
+
+    // after a full sweep every cell is consistent
+    rhs = cost;
+}
+
+//###################################################
+//                                        UPDATE CELL
+//###################################################
+void HolonomicHeuristic::updateCell(int idx)
+{
+    int x = idx % width;
+    int y = idx / width;
+
+    // the goal keeps its cost regardless of its occupancy
+    if (x == goalX && y == goalY)
+    {
+        return;
+    }
+
+    rhs[idx] = unreachable;
+
+    // the best cost over all neighbors, blocked cells can not be entered
+    if (!isBlocked(idx))
+    {
+        for (int i = 0; i < Node2D::dir; ++i)
+        {
+            int xPred = x + Node2D::dx[i];
+            int yPred = y + Node2D::dy[i];
+
+            if (xPred >= 0 && xPred < width && yPred >= 0 && yPred < height)
+            {
+                rhs[idx] = std::min(rhs[idx], cost[yPred * width + xPred] + movementCost(i));
+            }
+        }
+    }
+
+    // queue the cell with its new key if it is inconsistent, else dequeue it
+    if (cost[idx] != rhs[idx])
+    {
+        open.push(idx, std::min(cost[idx], rhs[idx]));
+    }
+    else
+    {
+        open.remove(idx);
+    }
+}
+
+//###################################################
+//                                      LPA* REPAIR
+//###################################################
+void HolonomicHeuristic::repair()
+{
+    open.clear();
+
+    for (int idx : pending)
+    {
+        updateCell(idx);
+    }
+
+    pending.clear();
+
+    while (!open.empty())
+    {
+        // pop the cell with the lowest key, it is inconsistent
+        int idx = open.top();
+        open.pop();
+
+        // the cell got cheaper, settle it
+        if (cost[idx] > rhs[idx])
+        {
+            cost[idx] = rhs[idx];
+        }
+        // the cell got more expensive, raise it and have it settle again
+        else
+        {
+            cost[idx] = unreachable;
+            updateCell(idx);
+        }
+
+        // propagate the change to the neighbors
+        int x = idx % width;
+        int y = idx / width;
+
+        for (int i = 0; i < Node2D::dir; ++i)
+        {
+            int xSucc = x + Node2D::dx[i];
+            int ySucc = y + Node2D::dy[i];
+
+            if (xSucc >= 0 && xSucc < width && ySucc >= 0 && ySucc < height)
+            {
+                updateCell(ySucc * width + xSucc);
+            }
+        }
+    }
+}
@@ -0,0 +1,186 @@
+#include "lookupcache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include "lookup.h"
+
+using namespace HybridAStar;
+
+// the magic number of the file
+static const char magicNumber[8] = {'H', 'Y', 'A', 'S', 'L', 'K', 'U', 'P'};
+
+//###################################################
+//                                        CONSTRUCTOR
+//###################################################
+LookupCache::LookupCache() : dubinsLookup(nullptr), mapping(nullptr), mappingSize(0)
+{
+}
+
+LookupCache::~LookupCache()
+{
+    wait();
+
+    if (mapping != nullptr)
+    {
+        munmap(mapping, mappingSize);
+    }
+}
+
+//###################################################
+//                                               OPEN
+//###################################################
+void LookupCache::open(const std::string& path)
+{
+    if (!Constants::dubinsLookup || getDubinsLookup() != nullptr || builder.joinable())
+    {
+        return;
+    }
+
+    if (!map(path))
+    {
+        if (Constants::coutDEBUG)
+        {
+            std::cout << "The lookup cache " << path << " does not match, rebuilding it in the background" << std::endl;
+        }
+
+        builder = std::thread(&LookupCache::build, this, path);
+    }
+}
+
+//###################################################
+//                                               WAIT
+//###################################################
+void LookupCache::wait()
+{
+    if (builder.joinable())
+    {
+        builder.join();
+    }
+}
+
+//###################################################
+//                                             HEADER
+//###################################################
+LookupCache::Header LookupCache::header()
+{
+    Header header;
+    // clear the padding so that headers can be compared bytewise
+    std::memset(&header, 0, sizeof(Header));
+    std::memcpy(header.magic, magicNumber, sizeof(magicNumber));
+    header.version                = version;
+    header.key.headings           = Constants::headings;
+    header.key.positionResolution = Constants::positionResolution;
+    header.key.dubinsWidth        = Constants::dubinsWidth;
+    header.key.reedsShepp         = Constants::reverse && !Constants::dubins;
+    header.key.cellSize           = Constants::cellSize;
+    header.key.r                  = Constants::r;
+    header.key.length             = Constants::length;
+    header.key.width              = Constants::width;
+    header.size                   = Constants::dubinsLookupSize;
+    return header;
+}
+
+//###################################################
+//                                           CHECKSUM
+//###################################################
+uint64_t LookupCache::checksum(const void* data, size_t bytes)
+{
+    const unsigned char* byte = static_cast<const unsigned char*>(data);
+    uint64_t             hash = 14695981039346656037ull;
+
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        hash ^= byte[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+//###################################################
+//                                                MAP
+//###################################################
+bool LookupCache::map(const std::string& path)
+{
+    int file = ::open(path.c_str(), O_RDONLY);
+
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+    Header      expected = header();
+    size_t      size     = sizeof(Header) + expected.size * sizeof(float);
+
+    if (fstat(file, &status) != 0 || (size_t)status.st_size != size)
+    {
+        close(file);
+        return false;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    // compare everything but the checksum, then verify the entries against it
+    Header        found   = *static_cast<const Header*>(data);
+    const float*  entries = reinterpret_cast<const float*>(static_cast<const char*>(data) + sizeof(Header));
+    expected.checksum     = found.checksum;
+
+    if (std::memcmp(&found, &expected, sizeof(Header)) != 0 ||
+        checksum(entries, expected.size * sizeof(float)) != found.checksum)
+    {
+        munmap(data, size);
+        return false;
+    }
+
+    mapping     = data;
+    mappingSize = size;
+    dubinsLookup.store(entries, std::memory_order_release);
+    return true;
+}
+
+//###################################################
+//                                              BUILD
+//###################################################
+void LookupCache::build(const std::string& path)
+{
+    table.resize(Constants::dubinsLookupSize);
+    Lookup::dubinsLookup(table.data());
+    // the searches can use the lookup from now on
+    dubinsLookup.store(table.data(), std::memory_order_release);
+
+    // _____________
+    // WRITE THE FILE
+    // written under a temporary name and renamed, so that a file of that name is always complete
+    Header header    = LookupCache::header();
+    header.checksum  = checksum(table.data(), table.size() * sizeof(float));
+    std::string temp = path + ".tmp";
+    FILE*       file = std::fopen(temp.c_str(), "wb");
+
+    bool written = file != nullptr && std::fwrite(&header, sizeof(Header), 1, file) == 1 &&
+                   std::fwrite(table.data(), sizeof(float), table.size(), file) == table.size();
+
+    if (file != nullptr)
+    {
+        written = std::fclose(file) == 0 && written;
+    }
+
+    if (!written || std::rename(temp.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temp.c_str());
+        std::cout << "The lookup cache " << path << " could not be written" << std::endl;
+    }
+}
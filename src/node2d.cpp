@@ -19,11 +19,11 @@ bool Node2D::isOnGrid(const int width, const int height) const
 //###################################################
 //                                   CREATE SUCCESSOR
 //###################################################
-Node2D* Node2D::createSuccessor(const int i)
+void Node2D::createSuccessor(const int i, Node2D& successor)
 {
     int xSucc = x + Node2D::dx[i];
     int ySucc = y + Node2D::dy[i];
-    return new Node2D(xSucc, ySucc, g, 0, this);
+    successor = Node2D(xSucc, ySucc, g, 0, this);
 }
 
 //###################################################
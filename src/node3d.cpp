@@ -37,10 +37,10 @@ float Node3D::getDist(const Node3D& node)
 //###################################################
 //                                         IS ON GRID
 //###################################################
-bool Node3D::isOnGrid(const int width, const int height) const
+bool Node3D::isOnGrid(const int width, const int height, const PlannerConfig& config) const
 {
-    return x >= 0 && x < width && y >= 0 && y < height && (int)(t / Constants::deltaHeadingRad) >= 0 &&
-           (int)(t / Constants::deltaHeadingRad) < Constants::headings;
+    return x >= 0 && x < width && y >= 0 && y < height && (int)(t / config.deltaHeadingRad) >= 0 &&
+           (int)(t / config.deltaHeadingRad) < config.headings;
 }
 
 //###################################################
@@ -57,7 +57,7 @@ bool Node3D::isInRange(const Node3D& goal) const
 //###################################################
 //                                   CREATE SUCCESSOR
 //###################################################
-Node3D* Node3D::createSuccessor(const int i)
+void Node3D::createSuccessor(const int i, Node3D& successor)
 {
     float xSucc;
     float ySucc;
@@ -78,31 +78,22 @@ Node3D* Node3D::createSuccessor(const int i)
         tSucc = Helper::normalizeHeadingRad(t - dt[i - 3]);
     }
 
-    return new Node3D(xSucc, ySucc, tSucc, g, 0, this, i);
-}
-
-Node3D* Node3D::new_createSuccessor(const int i)
-{
-    float xSucc = x + delta_x_[i] * cos(t) - delta_y_[i] * sin(t);
-    float ySucc = y + delta_x_[i] * sin(t) + delta_y_[i] * cos(t);
-    float tSucc = Helper::normalizeHeadingRad(t + delta_t_[i]);
-
-    return new Node3D(xSucc, ySucc, tSucc, g, 0, this, i);
+    successor = Node3D(xSucc, ySucc, tSucc, g, 0, i);
 }
 
 //###################################################
 //                                      MOVEMENT COST
 //###################################################
-void Node3D::updateG()
+void Node3D::updateG(const Node3D& pred, const PlannerConfig& config)
 {
     // forward driving
-    if (prim < forward_size_)
+    if (!config.isReverse(prim))
     {
         // penalize turning  目的是维持上一时刻的姿态
-        if (pred->prim != prim)  // TBD 如果节点分层拓展会有方向重合的情况
+        if (pred.prim != prim)  // TBD 如果节点分层拓展会有方向重合的情况
         {
             // penalize change of direction
-            if (pred->prim >= forward_size_)
+            if (config.isReverse(pred.prim))
             {
                 g += dx[0] * Constants::penaltyTurning *
                      Constants::penaltyCOD;  // TBD 不能 ＋dx[0]，需要根据实际的距离确定值
@@ -121,10 +112,10 @@ void Node3D::updateG()
     else
     {
         // penalize turning and reversing
-        if (pred->prim != prim)
+        if (pred.prim != prim)
         {
             // penalize change of direction
-            if (pred->prim < forward_size_)
+            if (!config.isReverse(pred.prim))
             {
                 g += dx[0] * Constants::penaltyTurning * Constants::penaltyReversing *
                      Constants::penaltyCOD;  // TBD 同上
@@ -339,3 +330,10 @@ bool Node3D::operator==(const Node3D& rhs) const
     return (int)x == (int)rhs.x && (int)y == (int)rhs.y &&
            (std::abs(t - rhs.t) <= Constants::deltaHeadingRad || std::abs(t - rhs.t) >= Constants::deltaHeadingNegRad);
 }
+
+bool Node3D::isSimilar(const Node3D& rhs, float deltaHeadingRad) const
+{
+    const float deltaHeadingNegRad = 2 * M_PI - deltaHeadingRad;
+    return (int)x == (int)rhs.x && (int)y == (int)rhs.y &&
+           (std::abs(t - rhs.t) <= deltaHeadingRad || std::abs(t - rhs.t) >= deltaHeadingNegRad);
+}
@@ -0,0 +1,115 @@
+#include "node3dstore.h"
+
+using namespace HybridAStar;
+
+// the initial number of slots as a power of two
+static const int initialBits = 14;
+
+//###################################################
+//                                        CONSTRUCTOR
+//###################################################
+Node3DStore::Node3DStore()
+{
+    table.assign(1 << initialBits, Slot{0, 0, 0});
+    mask       = (1 << initialBits) - 1;
+    shift      = 32 - initialBits;
+    count      = 0;
+    generation = 1;
+}
+
+//###################################################
+//                                              CLEAR
+//###################################################
+void Node3DStore::clear()
+{
+    count = 0;
+    generation++;
+
+    // the counter wrapped around, old slots could appear valid again
+    if (generation == 0)
+    {
+        table.assign(table.size(), Slot{0, 0, 0});
+        generation = 1;
+    }
+}
+
+//###################################################
+//                                             INSERT
+//###################################################
+int Node3DStore::insert(int idx, uint32_t i)
+{
+    // keep the load factor at or below one half so probe sequences stay short
+    if (2 * (count + 1) > (int)table.size())
+    {
+        grow();
+        i = hash(idx);
+
+        while (table[i].generation == generation)
+        {
+            i = (i + 1) & mask;
+        }
+    }
+
+    table[i].key        = idx;
+    table[i].node       = count;
+    table[i].generation = generation;
+
+    // the arrays are reused across searches, start from an unvisited node
+    if (count == (int)nodes.size())
+    {
+        nodes.emplace_back();
+        poses.push_back(Pose{0, 0, 0, idx});
+    }
+    else
+    {
+        nodes[count] = SearchNode();
+        poses[count] = Pose{0, 0, 0, idx};
+    }
+
+    return count++;
+}
+
+//###################################################
+//                                             APPEND
+//###################################################
+int Node3DStore::append(const Node3D& node, uint32_t pred)
+{
+    if (count == (int)nodes.size())
+    {
+        nodes.emplace_back();
+        poses.emplace_back();
+    }
+    else
+    {
+        nodes[count] = SearchNode();
+    }
+
+    set(count, node, pred);
+    return count++;
+}
+
+//###################################################
+//                                               GROW
+//###################################################
+void Node3DStore::grow()
+{
+    std::vector<Slot> old(2 * table.size(), Slot{0, 0, 0});
+    old.swap(table);
+    mask = table.size() - 1;
+    shift--;
+
+    for (const Slot& slot : old)
+    {
+        if (slot.generation == generation)
+        {
+            uint32_t i = hash(slot.key);
+
+            while (table[i].generation == generation)
+            {
+                i = (i + 1) & mask;
+            }
+
+            table[i] = slot;
+        }
+    }
+}
@@ -1,15 +1,26 @@
 #include "planner.h"
 
+#include <ros/package.h>
+#include <sys/stat.h>
+
+#include "yaml-cpp/yaml.h"
+
 using namespace HybridAStar;
 //###################################################
 //                                        CONSTRUCTOR
 //###################################################
 Planner::Planner()
 {
-    // _____
-    // TODOS
-    //    initializeLookups();
-    // Lookup::collisionLookup(collisionLookup);
+    // _______
+    // LOOKUPS
+    initializeLookups();
+    // _____________
+    // CONFIGURATION
+    // the parameter file is given by the private parameter ~config, by default the param.yaml of the package
+    ros::NodeHandle("~").param<std::string>("config", configPath,
+                                            ros::package::getPath("hybrid_astar") + "/param/param.yaml");
+    reloadConfig();
+    configTimer = n.createTimer(ros::Duration(1), &Planner::checkConfig, this);
     // ___________________
     // COLLISION DETECTION
     //    CollisionDetection configurationSpace;
@@ -37,12 +48,45 @@ Planner::Planner()
 //###################################################
 void Planner::initializeLookups()
 {
-    if (Constants::dubinsLookup)
+    // mapped from the cache, or built in the background while the heuristic falls back to the analytical solutions
+    lookups.open(Constants::lookupCache);
+}
+
+//###################################################
+//                                      CONFIGURATION
+//###################################################
+bool Planner::reloadConfig()
+{
+    struct stat status;
+
+    if (stat(configPath.c_str(), &status) == 0)
     {
-        Lookup::dubinsLookup(dubinsLookup);
+        configModified = status.st_mtime;
     }
 
-    Lookup::collisionLookup(collisionLookup);
+    try
+    {
+        config = PlannerConfig::load(configPath);
+        // the footprints for the headings and the swept footprints of the primitives, rebuilt only if they changed
+        configurationSpace.updateHeadings(config->headings);
+        configurationSpace.updatePrimitives(config->deltaX, config->deltaY, config->deltaT);
+        return true;
+    }
+    catch (const YAML::Exception& e)
+    {
+        std::cout << "The configuration " << configPath << " could not be loaded: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void Planner::checkConfig(const ros::TimerEvent& event)
+{
+    struct stat status;
+
+    if (stat(configPath.c_str(), &status) == 0 && status.st_mtime != configModified)
+    {
+        reloadConfig();
+    }
 }
 
 //###################################################
@@ -55,6 +99,28 @@ void Planner::setMap(const nav_msgs::OccupancyGrid::Ptr map)
         std::cout << "I am seeing the map..." << std::endl;
     }
 
+    // collect the cells whose occupancy changed if the map keeps its size
+    if (grid && grid->info.width == map->info.width && grid->info.height == map->info.height)
+    {
+        changedCells.clear();
+
+        for (size_t i = 0; i < map->data.size(); ++i)
+        {
+            if ((grid->data[i] != 0) != (map->data[i] != 0))
+            {
+                changedCells.push_back(i);
+            }
+        }
+
+        // repair the holonomic with obstacles heuristic where the map changed
+        holonomic.updateMap(map, changedCells);
+    }
+    else
+    {
+        // invalidate the holonomic with obstacles heuristic
+        holonomic.setMap(map);
+    }
+
     grid = map;
     // update the configuration space with the current map
     configurationSpace.updateGrid(map);
@@ -81,6 +147,8 @@ void Planner::setMap(const nav_msgs::OccupancyGrid::Ptr map)
     voronoiDiagram.initializeMap(width, height, binMap);
     voronoiDiagram.update();
     voronoiDiagram.visualize();
+    // classify the cells of the configuration space by their distance to the closest obstacle
+    configurationSpace.updateDistances(voronoiDiagram);
     //  ros::Time t1 = ros::Time::now();
     //  ros::Duration d(t1 - t0);
     //  std::cout << "created Voronoi Diagram in ms: " << d * 1000 << std::endl;
@@ -186,11 +254,8 @@ void Planner::plan()
         // LISTS ALLOWCATED ROW MAJOR ORDER
         int width  = grid->info.width;
         int height = grid->info.height;
-        int depth  = Constants::headings;
-        int length = width * height * depth;
-        // define list pointers and initialize lists
-        Node3D* nodes3D = new Node3D[length]();
-        Node2D* nodes2D = new Node2D[width * height]();
+        // start a new generation of the lists, the buffers of the previous plan are reused
+        workspace.prepare();
 
         // ________________________
         // retrieving goal position
@@ -199,10 +264,12 @@ void Planner::plan()
         float t = tf::getYaw(goal.pose.orientation);
         // set theta to a value (0,2PI]
         t = Helper::normalizeHeadingRad(t);
-        const Node3D nGoal(x, y, t, 0, 0, nullptr);
+        const Node3D nGoal(x, y, t, 0, 0);
+        // compute the holonomic with obstacles heuristic unless it is cached for this goal and map
+        holonomic.setGoal((int)x, (int)y);
         // __________
         // DEBUG GOAL
-        //    const Node3D nGoal(155.349, 36.1969, 0.7615936, 0, 0, nullptr);
+        //    const Node3D nGoal(155.349, 36.1969, 0.7615936, 0, 0);
 
         // _________________________
         // retrieving start position
@@ -211,10 +278,10 @@ void Planner::plan()
         t = tf::getYaw(start.pose.pose.orientation);
         // set theta to a value (0,2PI]
         t = Helper::normalizeHeadingRad(t);
-        Node3D nStart(x, y, t, 0, 0, nullptr);
+        Node3D nStart(x, y, t, 0, 0);
         // ___________
         // DEBUG START
-        //    Node3D nStart(108.291, 30.1081, 0, 0, 0, nullptr);
+        //    Node3D nStart(108.291, 30.1081, 0, 0, 0);
 
         // ___________________________
         // START AND TIME THE PLANNING
@@ -226,14 +293,14 @@ void Planner::plan()
         path.clear();
         smoothedPath.clear();
         // FIND THE PATH
-        Node3D* nSolution = Algorithm::hybridAStar(nStart, nGoal, nodes3D, nodes2D, width, height, configurationSpace,
-                                                   dubinsLookup, visualization);
+        int pSolution = Algorithm::hybridAStar(nStart, nGoal, workspace, holonomic, width, height, configurationSpace,
+                                               lookups.getDubinsLookup(), *config, visualization);
         // TRACE THE PATH
-        smoother.tracePath(nSolution);
+        smoother.tracePath(workspace.nodes3D, pSolution);
         // CREATE THE UPDATED PATH
         path.updatePath(smoother.getPath());
         // SMOOTH THE PATH
-        smoother.smoothPath(voronoiDiagram);
+        smoother.smoothPath(voronoiDiagram, configurationSpace, *config);
         // CREATE THE UPDATED PATH
         smoothedPath.updatePath(smoother.getPath());
         ros::Time     t1 = ros::Time::now();
@@ -248,11 +315,13 @@ void Planner::plan()
         smoothedPath.publishPath();
         smoothedPath.publishPathNodes();
         smoothedPath.publishPathVehicles();
-        visualization.publishNode3DCosts(nodes3D, width, height, depth);
-        visualization.publishNode2DCosts(nodes2D, width, height);
+        visualization.publishNode3DCosts(workspace.nodes3D, width, height);
 
-        delete[] nodes3D;
-        delete[] nodes2D;
+        // the field covers the whole map, only publish it on demand
+        if (Constants::visualization2D)
+        {
+            visualization.publishNode2DCosts(holonomic, width, height);
+        }
     }
     else
     {
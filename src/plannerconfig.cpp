@@ -0,0 +1,101 @@
+#include "plannerconfig.h"
+
+#include <cmath>
+
+#include "constants.h"
+#include "heuristic.h"
+#include "yaml-cpp/yaml.h"
+
+using namespace HybridAStar;
+
+//###################################################
+//                                        CONSTRUCTOR
+//###################################################
+PlannerConfig::PlannerConfig()
+{
+    succSize     = 6;
+    forwardSize  = 3;
+    backwardSize = 3;
+    stepSize     = {6, 6, 6, 6, 6, 6};
+    deltaTEdg    = {0, 6.75, -6.75, 0, -6.75, 6.75};
+    // a single discretization of the heading
+    headings       = Constants::headings;
+    coarseHeadings = Constants::headings;
+    fineDistance   = 0;
+    compile();
+}
+
+//###################################################
+//                                               LOAD
+//###################################################
+std::shared_ptr<const PlannerConfig> PlannerConfig::load(const std::string& path)
+{
+    YAML::Node                     param  = YAML::LoadFile(path);
+    std::shared_ptr<PlannerConfig> config = std::make_shared<PlannerConfig>();
+
+    config->succSize     = param["succ_size"].as<int>();
+    config->forwardSize  = param["forward_size"].as<int>();
+    config->backwardSize = param["backward_size"].as<int>();
+    config->stepSize     = param["step_size"].as<std::vector<float>>();
+    config->deltaTEdg    = param["delta_t_edg"].as<std::vector<float>>();
+    // the discretization of the heading is optional, the coarse headings default to the fine ones
+    config->headings       = param["headings"] ? param["headings"].as<int>() : Constants::headings;
+    config->coarseHeadings = param["coarse_headings"] ? param["coarse_headings"].as<int>() : config->headings;
+    config->fineDistance   = param["fine_heading_distance"] ? param["fine_heading_distance"].as<float>() : 0;
+
+    // the successors of an expansion are created into and evaluated as one batch
+    if (config->succSize <= 0 || config->succSize > HeuristicBatch::capacity)
+    {
+        throw YAML::Exception(YAML::Mark::null_mark(), "the number of primitives has to be between 1 and " +
+                                                           std::to_string(HeuristicBatch::capacity) + " in " + path);
+    }
+
+    if ((int)config->stepSize.size() < config->succSize || (int)config->deltaTEdg.size() < config->succSize)
+    {
+        throw YAML::Exception(YAML::Mark::null_mark(), "fewer step sizes or headings than primitives in " + path);
+    }
+
+    if (config->headings <= 0 || config->coarseHeadings <= 0)
+    {
+        throw YAML::Exception(YAML::Mark::null_mark(), "the number of headings has to be positive in " + path);
+    }
+
+    config->compile();
+    return config;
+}
+
+//###################################################
+//                                            COMPILE
+//###################################################
+void PlannerConfig::compile()
+{
+    stepLength.resize(succSize);
+    deltaX.resize(succSize);
+    deltaY.resize(succSize);
+    deltaT.resize(succSize);
+    primitives.resize(succSize);
+
+    for (int i = 0; i < succSize; ++i)
+    {
+        // the given step sizes are kept, so compiling again yields the same primitives
+        stepLength[i] = stepSize[i] * Constants::primitiveStepUnit;
+
+        if (i < forwardSize)
+        {
+            deltaT[i] = deltaTEdg[i] * M_PI / 180;
+            deltaX[i] = stepLength[i] * std::fabs(std::cos(deltaT[i]));
+            deltaY[i] = (-1) * stepLength[i] * std::sin(deltaT[i]);
+        }
+        else
+        {
+            deltaT[i] = deltaTEdg[i] / 180 * M_PI;
+            deltaX[i] = stepLength[i] * std::fabs(std::cos(deltaT[i])) * (-1);
+            deltaY[i] = stepLength[i] * std::sin(deltaT[i]);
+        }
+
+        primitives[i] = Primitive{deltaX[i], deltaY[i], deltaT[i]};
+    }
+
+    deltaHeadingRad       = 2 * M_PI / (float)headings;
+    coarseDeltaHeadingRad = 2 * M_PI / (float)coarseHeadings;
+}
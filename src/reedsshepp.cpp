@@ -0,0 +1,762 @@
+#include "reedsshepp.h"
+
+#define _USE_MATH_DEFINES  // for C++
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace HybridAStar
+{
+
+// The segment types for each of the path types
+const ReedsSheppSegmentType reeds_shepp_words[RS_TYPES][5] = {
+    {RS_LEFT, RS_RIGHT, RS_LEFT, RS_NOP, RS_NOP},         // 0
+    {RS_RIGHT, RS_LEFT, RS_RIGHT, RS_NOP, RS_NOP},        // 1
+    {RS_LEFT, RS_RIGHT, RS_LEFT, RS_RIGHT, RS_NOP},       // 2
+    {RS_RIGHT, RS_LEFT, RS_RIGHT, RS_LEFT, RS_NOP},       // 3
+    {RS_LEFT, RS_RIGHT, RS_STRAIGHT, RS_LEFT, RS_NOP},    // 4
+    {RS_RIGHT, RS_LEFT, RS_STRAIGHT, RS_RIGHT, RS_NOP},   // 5
+    {RS_LEFT, RS_STRAIGHT, RS_RIGHT, RS_LEFT, RS_NOP},    // 6
+    {RS_RIGHT, RS_STRAIGHT, RS_LEFT, RS_RIGHT, RS_NOP},   // 7
+    {RS_LEFT, RS_RIGHT, RS_STRAIGHT, RS_RIGHT, RS_NOP},   // 8
+    {RS_RIGHT, RS_LEFT, RS_STRAIGHT, RS_LEFT, RS_NOP},    // 9
+    {RS_RIGHT, RS_STRAIGHT, RS_RIGHT, RS_LEFT, RS_NOP},   // 10
+    {RS_LEFT, RS_STRAIGHT, RS_LEFT, RS_RIGHT, RS_NOP},    // 11
+    {RS_LEFT, RS_STRAIGHT, RS_RIGHT, RS_NOP, RS_NOP},     // 12
+    {RS_RIGHT, RS_STRAIGHT, RS_LEFT, RS_NOP, RS_NOP},     // 13
+    {RS_LEFT, RS_STRAIGHT, RS_LEFT, RS_NOP, RS_NOP},      // 14
+    {RS_RIGHT, RS_STRAIGHT, RS_RIGHT, RS_NOP, RS_NOP},    // 15
+    {RS_LEFT, RS_RIGHT, RS_STRAIGHT, RS_LEFT, RS_RIGHT},  // 16
+    {RS_RIGHT, RS_LEFT, RS_STRAIGHT, RS_RIGHT, RS_LEFT}   // 17
+};
+
+namespace
+{
+// tolerance for the sign of segment lengths
+const double ZERO = 10 * std::numeric_limits<double>::epsilon();
+
+// the best path found so far, in units of the turning radius
+struct Candidate
+{
+    double param[5];
+    double length;
+    int    type;
+};
+
+// the angle wrapped to [-pi, pi]
+inline double wrapToPi(double x)
+{
+    double v = std::fmod(x, 2 * M_PI);
+
+    if (v < -M_PI)
+    {
+        v += 2 * M_PI;
+    }
+    else if (v > M_PI)
+    {
+        v -= 2 * M_PI;
+    }
+
+    return v;
+}
+
+inline void polar(double x, double y, double& r, double& theta)
+{
+    r     = std::sqrt(x * x + y * y);
+    theta = std::atan2(y, x);
+}
+
+inline void tauOmega(double u, double v, double xi, double eta, double phi, double& tau, double& omega)
+{
+    double delta = wrapToPi(u - v);
+    double A     = std::sin(u) - std::sin(delta);
+    double B     = std::cos(u) - std::cos(delta) - 1.;
+    double t1    = std::atan2(eta * A - xi * B, xi * A + eta * B);
+    double t2    = 2. * (std::cos(delta) - std::cos(v) - std::cos(u)) + 3;
+    tau          = (t2 < 0) ? wrapToPi(t1 + M_PI) : wrapToPi(t1);
+    omega        = wrapToPi(tau - u + v - phi);
+}
+
+// all paths found, sorted by increasing length
+struct Candidates
+{
+    Candidate paths[RS_CANDIDATES];
+    int       size;
+};
+
+// keeps the path if it is shorter than the best one so far
+inline void consider(Candidate& best, int type, double t, double u, double v, double w = 0, double x = 0)
+{
+    double length = std::fabs(t) + std::fabs(u) + std::fabs(v) + std::fabs(w) + std::fabs(x);
+
+    if (length < best.length)
+    {
+        best.param[0] = t;
+        best.param[1] = u;
+        best.param[2] = v;
+        best.param[3] = w;
+        best.param[4] = x;
+        best.length   = length;
+        best.type     = type;
+    }
+}
+
+// inserts the path by its length, paths of equal length stay in the order they were found
+inline void consider(Candidates& all, int type, double t, double u, double v, double w = 0, double x = 0)
+{
+    double length = std::fabs(t) + std::fabs(u) + std::fabs(v) + std::fabs(w) + std::fabs(x);
+    int    i      = all.size++;
+
+    for (; i > 0 && all.paths[i - 1].length > length; --i)
+    {
+        all.paths[i] = all.paths[i - 1];
+    }
+
+    all.paths[i].param[0] = t;
+    all.paths[i].param[1] = u;
+    all.paths[i].param[2] = v;
+    all.paths[i].param[3] = w;
+    all.paths[i].param[4] = x;
+    all.paths[i].length   = length;
+    all.paths[i].type     = type;
+}
+
+// formula 8.1
+inline bool LpSpLp(double x, double y, double phi, double& t, double& u, double& v)
+{
+    polar(x - std::sin(phi), y - 1. + std::cos(phi), u, t);
+
+    if (t >= -ZERO)
+    {
+        v = wrapToPi(phi - t);
+        return v >= -ZERO;
+    }
+
+    return false;
+}
+
+// formula 8.2
+inline bool LpSpRp(double x, double y, double phi, double& t, double& u, double& v)
+{
+    double t1, u1;
+    polar(x + std::sin(phi), y - 1. - std::cos(phi), u1, t1);
+    u1 = u1 * u1;
+
+    if (u1 >= 4.)
+    {
+        u            = std::sqrt(u1 - 4.);
+        double theta = std::atan2(2., u);
+        t            = wrapToPi(t1 + theta);
+        v            = wrapToPi(t - phi);
+        return t >= -ZERO && v >= -ZERO;
+    }
+
+    return false;
+}
+
+template <typename Paths>
+void CSC(double x, double y, double phi, Paths& best)
+{
+    double t, u, v;
+
+    if (LpSpLp(x, y, phi, t, u, v))
+    {
+        consider(best, 14, t, u, v);
+    }
+
+    // timeflip
+    if (LpSpLp(-x, y, -phi, t, u, v))
+    {
+        consider(best, 14, -t, -u, -v);
+    }
+
+    // reflect
+    if (LpSpLp(x, -y, -phi, t, u, v))
+    {
+        consider(best, 15, t, u, v);
+    }
+
+    // timeflip + reflect
+    if (LpSpLp(-x, -y, phi, t, u, v))
+    {
+        consider(best, 15, -t, -u, -v);
+    }
+
+    if (LpSpRp(x, y, phi, t, u, v))
+    {
+        consider(best, 12, t, u, v);
+    }
+
+    // timeflip
+    if (LpSpRp(-x, y, -phi, t, u, v))
+    {
+        consider(best, 12, -t, -u, -v);
+    }
+
+    // reflect
+    if (LpSpRp(x, -y, -phi, t, u, v))
+    {
+        consider(best, 13, t, u, v);
+    }
+
+    // timeflip + reflect
+    if (LpSpRp(-x, -y, phi, t, u, v))
+    {
+        consider(best, 13, -t, -u, -v);
+    }
+}
+
+// formula 8.3 / 8.4, with the correction of the typo in the paper
+inline bool LpRmL(double x, double y, double phi, double& t, double& u, double& v)
+{
+    double xi = x - std::sin(phi), eta = y - 1. + std::cos(phi), u1, theta;
+    polar(xi, eta, u1, theta);
+
+    if (u1 <= 4.)
+    {
+        u = -2. * std::asin(.25 * u1);
+        t = wrapToPi(theta + .5 * u + M_PI);
+        v = wrapToPi(phi - t + u);
+        return t >= -ZERO && u <= ZERO;
+    }
+
+    return false;
+}
+
+template <typename Paths>
+void CCC(double x, double y, double phi, Paths& best)
+{
+    double t, u, v;
+
+    if (LpRmL(x, y, phi, t, u, v))
+    {
+        consider(best, 0, t, u, v);
+    }
+
+    // timeflip
+    if (LpRmL(-x, y, -phi, t, u, v))
+    {
+        consider(best, 0, -t, -u, -v);
+    }
+
+    // reflect
+    if (LpRmL(x, -y, -phi, t, u, v))
+    {
+        consider(best, 1, t, u, v);
+    }
+
+    // timeflip + reflect
+    if (LpRmL(-x, -y, phi, t, u, v))
+    {
+        consider(best, 1, -t, -u, -v);
+    }
+
+    // backwards
+    double xb = x * std::cos(phi) + y * std::sin(phi), yb = x * std::sin(phi) - y * std::cos(phi);
+
+    if (LpRmL(xb, yb, phi, t, u, v))
+    {
+        consider(best, 0, v, u, t);
+    }
+
+    // timeflip
+    if (LpRmL(-xb, yb, -phi, t, u, v))
+    {
+        consider(best, 0, -v, -u, -t);
+    }
+
+    // reflect
+    if (LpRmL(xb, -yb, -phi, t, u, v))
+    {
+        consider(best, 1, v, u, t);
+    }
+
+    // timeflip + reflect
+    if (LpRmL(-xb, -yb, phi, t, u, v))
+    {
+        consider(best, 1, -v, -u, -t);
+    }
+}
+
+// formula 8.7
+inline bool LpRupLumRm(double x, double y, double phi, double& t, double& u, double& v)
+{
+    double xi = x + std::sin(phi), eta = y - 1. - std::cos(phi), rho = .25 * (2. + std::sqrt(xi * xi + eta * eta));
+
+    if (rho <= 1.)
+    {
+        u = std::acos(rho);
+        tauOmega(u, -u, xi, eta, phi, t, v);
+        return t >= -ZERO && v <= ZERO;
+    }
+
+    return false;
+}
+
+// formula 8.8
+inline bool LpRumLumRp(double x, double y, double phi, double& t, double& u, double& v)
+{
+    double xi = x + std::sin(phi), eta = y - 1. - std::cos(phi), rho = (20. - xi * xi - eta * eta) / 16.;
+
+    if (rho >= 0 && rho <= 1)
+    {
+        u = -std::acos(rho);
+
+        if (u >= -.5 * M_PI)
+        {
+            tauOmega(u, u, xi, eta, phi, t, v);
+            return t >= -ZERO && v >= -ZERO;
+        }
+    }
+
+    return false;
+}
+
+template <typename Paths>
+void CCCC(double x, double y, double phi, Paths& best)
+{
+    double t, u, v;
+
+    if (LpRupLumRm(x, y, phi, t, u, v))
+    {
+        consider(best, 2, t, u, -u, v);
+    }
+
+    // timeflip
+    if (LpRupLumRm(-x, y, -phi, t, u, v))
+    {
+        consider(best, 2, -t, -u, u, -v);
+    }
+
+    // reflect
+    if (LpRupLumRm(x, -y, -phi, t, u, v))
+    {
+        consider(best, 3, t, u, -u, v);
+    }
+
+    // timeflip + reflect
+    if (LpRupLumRm(-x, -y, phi, t, u, v))
+    {
+        consider(best, 3, -t, -u, u, -v);
+    }
+
+    if (LpRumLumRp(x, y, phi, t, u, v))
+    {
+        consider(best, 2, t, u, u, v);
+    }
+
+    // timeflip
+    if (LpRumLumRp(-x, y, -phi, t, u, v))
+    {
+        consider(best, 2, -t, -u, -u, -v);
+    }
+
+    // reflect
+    if (LpRumLumRp(x, -y, -phi, t, u, v))
+    {
+        consider(best, 3, t, u, u, v);
+    }
+
+    // timeflip + reflect
+    if (LpRumLumRp(-x, -y, phi, t, u, v))
+    {
+        consider(best, 3, -t, -u, -u, -v);
+    }
+}
+
+// formula 8.9
+inline bool LpRmSmLm(double x, double y, double phi, double& t, double& u, double& v)
+{
+    double xi = x - std::sin(phi), eta = y - 1. + std::cos(phi), rho, theta;
+    polar(xi, eta, rho, theta);
+
+    if (rho >= 2.)
+    {
+        double r = std::sqrt(rho * rho - 4.);
+        u        = 2. - r;
+        t        = wrapToPi(theta + std::atan2(r, -2.));
+        v        = wrapToPi(phi - .5 * M_PI - t);
+        return t >= -ZERO && u <= ZERO && v <= ZERO;
+    }
+
+    return false;
+}
+
+// formula 8.10
+inline bool LpRmSmRm(double x, double y, double phi, double& t, double& u, double& v)
+{
+    double xi = x + std::sin(phi), eta = y - 1. - std::cos(phi), rho, theta;
+    polar(-eta, xi, rho, theta);
+
+    if (rho >= 2.)
+    {
+        t = theta;
+        u = 2. - rho;
+        v = wrapToPi(t + .5 * M_PI - phi);
+        return t >= -ZERO && u <= ZERO && v <= ZERO;
+    }
+
+    return false;
+}
+
+template <typename Paths>
+void CCSC(double x, double y, double phi, Paths& best)
+{
+    const double h = .5 * M_PI;
+    double       t, u, v;
+
+    if (LpRmSmLm(x, y, phi, t, u, v))
+    {
+        consider(best, 4, t, -h, u, v);
+    }
+
+    // timeflip
+    if (LpRmSmLm(-x, y, -phi, t, u, v))
+    {
+        consider(best, 4, -t, h, -u, -v);
+    }
+
+    // reflect
+    if (LpRmSmLm(x, -y, -phi, t, u, v))
+    {
+        consider(best, 5, t, -h, u, v);
+    }
+
+    // timeflip + reflect
+    if (LpRmSmLm(-x, -y, phi, t, u, v))
+    {
+        consider(best, 5, -t, h, -u, -v);
+    }
+
+    if (LpRmSmRm(x, y, phi, t, u, v))
+    {
+        consider(best, 8, t, -h, u, v);
+    }
+
+    // timeflip
+    if (LpRmSmRm(-x, y, -phi, t, u, v))
+    {
+        consider(best, 8, -t, h, -u, -v);
+    }
+
+    // reflect
+    if (LpRmSmRm(x, -y, -phi, t, u, v))
+    {
+        consider(best, 9, t, -h, u, v);
+    }
+
+    // timeflip + reflect
+    if (LpRmSmRm(-x, -y, phi, t, u, v))
+    {
+        consider(best, 9, -t, h, -u, -v);
+    }
+
+    // backwards
+    double xb = x * std::cos(phi) + y * std::sin(phi), yb = x * std::sin(phi) - y * std::cos(phi);
+
+    if (LpRmSmLm(xb, yb, phi, t, u, v))
+    {
+        consider(best, 6, v, u, -h, t);
+    }
+
+    // timeflip
+    if (LpRmSmLm(-xb, yb, -phi, t, u, v))
+    {
+        consider(best, 6, -v, -u, h, -t);
+    }
+
+    // reflect
+    if (LpRmSmLm(xb, -yb, -phi, t, u, v))
+    {
+        consider(best, 7, v, u, -h, t);
+    }
+
+    // timeflip + reflect
+    if (LpRmSmLm(-xb, -yb, phi, t, u, v))
+    {
+        consider(best, 7, -v, -u, h, -t);
+    }
+
+    if (LpRmSmRm(xb, yb, phi, t, u, v))
+    {
+        consider(best, 10, v, u, -h, t);
+    }
+
+    // timeflip
+    if (LpRmSmRm(-xb, yb, -phi, t, u, v))
+    {
+        consider(best, 10, -v, -u, h, -t);
+    }
+
+    // reflect
+    if (LpRmSmRm(xb, -yb, -phi, t, u, v))
+    {
+        consider(best, 11, v, u, -h, t);
+    }
+
+    // timeflip + reflect
+    if (LpRmSmRm(-xb, -yb, phi, t, u, v))
+    {
+        consider(best, 11, -v, -u, h, -t);
+    }
+}
+
+// formula 8.11, with the correction of the typo in the paper
+inline bool LpRmSLmRp(double x, double y, double phi, double& t, double& u, double& v)
+{
+    double xi = x + std::sin(phi), eta = y - 1. - std::cos(phi), rho, theta;
+    polar(xi, eta, rho, theta);
+
+    if (rho >= 2.)
+    {
+        u = 4. - std::sqrt(rho * rho - 4.);
+
+        if (u <= ZERO)
+        {
+            t = wrapToPi(std::atan2((4 - u) * xi - 2 * eta, -2 * xi + (u - 4) * eta));
+            v = wrapToPi(t - phi);
+            return t >= -ZERO && v >= -ZERO;
+        }
+    }
+
+    return false;
+}
+
+template <typename Paths>
+void CCSCC(double x, double y, double phi, Paths& best)
+{
+    const double h = .5 * M_PI;
+    double       t, u, v;
+
+    if (LpRmSLmRp(x, y, phi, t, u, v))
+    {
+        consider(best, 16, t, -h, u, -h, v);
+    }
+
+    // timeflip
+    if (LpRmSLmRp(-x, y, -phi, t, u, v))
+    {
+        consider(best, 16, -t, h, -u, h, -v);
+    }
+
+    // reflect
+    if (LpRmSLmRp(x, -y, -phi, t, u, v))
+    {
+        consider(best, 17, t, -h, u, -h, v);
+    }
+
+    // timeflip + reflect
+    if (LpRmSLmRp(-x, -y, phi, t, u, v))
+    {
+        consider(best, 17, -t, h, -u, h, -v);
+    }
+}
+
+// finds the paths to the configuration given relative to the start and in units of the turning radius
+template <typename Paths>
+inline void solve(const double q0[3], const double q1[3], double rho, Paths& best)
+{
+    double dx = q1[0] - q0[0], dy = q1[1] - q0[1];
+    double c = std::cos(q0[2]), s = std::sin(q0[2]);
+    double x = (c * dx + s * dy) / rho, y = (-s * dx + c * dy) / rho, phi = q1[2] - q0[2];
+
+    CSC(x, y, phi, best);
+    CCC(x, y, phi, best);
+    CCCC(x, y, phi, best);
+    CCSC(x, y, phi, best);
+    CCSCC(x, y, phi, best);
+}
+
+// finds the shortest path
+inline Candidate solve(const double q0[3], const double q1[3], double rho)
+{
+    Candidate best;
+    best.length = std::numeric_limits<double>::infinity();
+    best.type   = 0;
+    solve(q0, q1, rho, best);
+    return best;
+}
+}  // namespace
+
+int reeds_shepp_init(const double q0[3], const double q1[3], double rho, ReedsSheppPath* path)
+{
+    if (rho <= 0.0)
+    {
+        return ERSBADRHO;
+    }
+
+    Candidate best = solve(q0, q1, rho);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        path->qi[i] = q0[i];
+    }
+
+    for (int i = 0; i < 5; ++i)
+    {
+        path->param[i] = best.param[i];
+    }
+
+    path->rho  = rho;
+    path->type = best.type;
+    return ERSOK;
+}
+
+int reeds_shepp_init_all(const double q0[3], const double q1[3], double rho, ReedsSheppPath paths[RS_CANDIDATES],
+                         int* count)
+{
+    *count = 0;
+
+    if (rho <= 0.0)
+    {
+        return ERSBADRHO;
+    }
+
+    Candidates all;
+    all.size = 0;
+    solve(q0, q1, rho, all);
+
+    for (int k = 0; k < all.size; ++k)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            paths[k].qi[i] = q0[i];
+        }
+
+        for (int i = 0; i < 5; ++i)
+        {
+            paths[k].param[i] = all.paths[k].param[i];
+        }
+
+        paths[k].rho  = rho;
+        paths[k].type = all.paths[k].type;
+    }
+
+    *count = all.size;
+    return ERSOK;
+}
+
+double reeds_shepp_distance(const double q0[3], const double q1[3], double rho)
+{
+    return rho * solve(q0, q1, rho).length;
+}
+
+double reeds_shepp_path_length(const ReedsSheppPath* path)
+{
+    double length = 0;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        length += std::fabs(path->param[i]);
+    }
+
+    return length * path->rho;
+}
+
+int reeds_shepp_path_type(const ReedsSheppPath* path)
+{
+    return path->type;
+}
+
+int reeds_shepp_path_sample(const ReedsSheppPath* path, double t, double q[3])
+{
+    if (t < 0 || t > reeds_shepp_path_length(path))
+    {
+        return ERSPARAM;
+    }
+
+    // walk along the segments in units of the turning radius, starting at the origin
+    double seg = t / path->rho, x = 0, y = 0, phi = path->qi[2];
+
+    for (int i = 0; i < 5 && seg > 0; ++i)
+    {
+        double v;
+
+        if (path->param[i] < 0)
+        {
+            v = std::max(-seg, path->param[i]);
+            seg += v;
+        }
+        else
+        {
+            v = std::min(seg, path->param[i]);
+            seg -= v;
+        }
+
+        switch (reeds_shepp_words[path->type][i])
+        {
+            case RS_LEFT:
+                x += std::sin(phi + v) - std::sin(phi);
+                y += -std::cos(phi + v) + std::cos(phi);
+                phi += v;
+                break;
+
+            case RS_RIGHT:
+                x += -std::sin(phi - v) + std::sin(phi);
+                y += std::cos(phi - v) - std::cos(phi);
+                phi -= v;
+                break;
+
+            case RS_STRAIGHT:
+                x += v * std::cos(phi);
+                y += v * std::sin(phi);
+                break;
+
+            case RS_NOP:
+                break;
+        }
+    }
+
+    q[0] = x * path->rho + path->qi[0];
+    q[1] = y * path->rho + path->qi[1];
+    q[2] = phi;
+    return ERSOK;
+}
+
+int reeds_shepp_path_reversing(const ReedsSheppPath* path, double t)
+{
+    double seg = t / path->rho;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        // the sample lies within this segment
+        if (seg <= std::fabs(path->param[i]) && path->param[i] != 0)
+        {
+            return path->param[i] < 0;
+        }
+
+        seg -= std::fabs(path->param[i]);
+    }
+
+    return 0;
+}
+
+int reeds_shepp_path_sample_many(const ReedsSheppPath* path, ReedsSheppPathSamplingCallback cb, double stepSize,
+                                 void* user_data)
+{
+    double q[3];
+    double x      = 0.0;
+    double length = reeds_shepp_path_length(path);
+
+    while (x < length)
+    {
+        reeds_shepp_path_sample(path, x, q);
+        int retcode = cb(q, x, user_data);
+
+        if (retcode != 0)
+        {
+            return retcode;
+        }
+
+        x += stepSize;
+    }
+
+    return 0;
+}
+
+int reeds_shepp_path_endpoint(const ReedsSheppPath* path, double q[3])
+{
+    return reeds_shepp_path_sample(path, reeds_shepp_path_length(path), q);
+}
+
+}  // namespace HybridAStar
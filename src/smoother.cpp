@@ -3,16 +3,16 @@ using namespace HybridAStar;
 //###################################################
 //                                     CUSP DETECTION
 //###################################################
-inline bool isCusp(const std::vector<Node3D>& path, int i)  // TBD 判断路径中尖点逻辑
+inline bool isCusp(const std::vector<Node3D>& path, int i, const PlannerConfig& config)  // TBD 判断路径中尖点逻辑
 {
     // 可用替代逻辑：
     // 先根据prim判断前后方向
     // 再判断两个点的前后方向是否一致   这样值用判断 i 和 i-1
 
-    bool temp1 = path[i - 2].getPrim() < Node3D::forward_size_;
-    bool temp2 = path[i - 1].getPrim() < Node3D::forward_size_;
-    bool temp3 = path[i].getPrim() < Node3D::forward_size_;
-    bool temp4 = path[i + 1].getPrim() < Node3D::forward_size_;
+    bool temp1 = !config.isReverse(path[i - 2].getPrim());
+    bool temp2 = !config.isReverse(path[i - 1].getPrim());
+    bool temp3 = !config.isReverse(path[i].getPrim());
+    bool temp4 = !config.isReverse(path[i + 1].getPrim());
 
     return (temp1 != temp2 || temp2 != temp3 || temp3 != temp4);
 
@@ -31,7 +31,8 @@ inline bool isCusp(const std::vector<Node3D>& path, int i)  // TBD 判断路径
 //###################################################
 //                                SMOOTHING ALGORITHM
 //###################################################
-void Smoother::smoothPath(DynamicVoronoi& voronoi)
+void Smoother::smoothPath(DynamicVoronoi& voronoi, const CollisionDetection& configurationSpace,
+                          const PlannerConfig& config)
 {
     // load the current voronoi diagram into the smoother
     this->voronoi = voronoi;
@@ -44,9 +45,9 @@ void Smoother::smoothPath(DynamicVoronoi& voronoi)
     // the lenght of the path in number of nodes
     int pathLength = 0;
 
-    // path objects with all nodes oldPath the original, newPath the resulting smoothed path
-    pathLength                  = path.size();
-    std::vector<Node3D> newPath = path;
+    // the path is smoothed in place, every node is updated from its already updated neighbors
+    pathLength                   = path.size();
+    std::vector<Node3D>& newPath = path;
 
     // descent along the gradient untill the maximum number of iterations has been reached
     float totalWeight = wSmoothness + wCurvature + wVoronoi + wObstacle;
@@ -65,7 +66,7 @@ void Smoother::smoothPath(DynamicVoronoi& voronoi)
 
             // the following points shall not be smoothed
             // keep these points fixed if they are a cusp point or adjacent to one
-            if (isCusp(newPath, i))
+            if (isCusp(newPath, i, config))
             {
                 continue;
             }
@@ -96,6 +97,17 @@ void Smoother::smoothPath(DynamicVoronoi& voronoi)
             // ensure that it is on the grid
 
             xi = xi + alpha * correction / totalWeight;
+
+            // keep the node in place if the vehicle would collide at the corrected position
+            Node3D corrected = newPath[i];
+            corrected.setX(xi.getX());
+            corrected.setY(xi.getY());
+
+            if (!configurationSpace.isTraversable(&corrected))
+            {
+                continue;
+            }
+
             newPath[i].setX(xi.getX());
             newPath[i].setY(xi.getY());
             Vector2D Dxi = xi - xim1;
@@ -104,21 +116,26 @@ void Smoother::smoothPath(DynamicVoronoi& voronoi)
 
         iterations++;
     }
-
-    path = newPath;
 }
 
-void Smoother::tracePath(const Node3D* node, int i, std::vector<Node3D> path)
+void Smoother::tracePath(const Node3DStore& nodes, int position)
 {
-    if (node == nullptr)
+    // the length of the chain
+    int length = 0;
+
+    for (uint32_t i = position; position >= 0 && i != SearchNode::none; i = nodes.node(i).getPred())
     {
-        this->path = path;
-        return;
+        length++;
     }
 
-    i++;
-    path.push_back(*node);
-    tracePath(node->getPred(), i, path);
+    // the buffer of the previous path is reused
+    path.clear();
+    path.reserve(length);
+
+    for (uint32_t i = position; position >= 0 && i != SearchNode::none; i = nodes.node(i).getPred())
+    {
+        path.push_back(nodes.get(i));
+    }
 }
 
 //###################################################
@@ -35,7 +35,7 @@ void Visualize::clear()
 //###################################################
 //                                    CURRENT 3D NODE
 //###################################################
-void Visualize::publishNode3DPose(Node3D& node)
+void Visualize::publishNode3DPose(Node3D& node, const PlannerConfig& config)
 {
     geometry_msgs::PoseStamped pose;
     pose.header.frame_id = "path";
@@ -45,7 +45,7 @@ void Visualize::publishNode3DPose(Node3D& node)
     pose.pose.position.y = node.getY() * Constants::cellSize;
 
     // FORWARD
-    if (node.getPrim() < Node3D::forward_size_)
+    if (!config.isReverse(node.getPrim()))
     {
         pose.pose.orientation = tf::createQuaternionMsgFromYaw(node.getT());
     }
@@ -62,14 +62,14 @@ void Visualize::publishNode3DPose(Node3D& node)
 //###################################################
 //                              ALL EXPANDED 3D NODES
 //###################################################
-void Visualize::publishNode3DPoses(Node3D& node)
+void Visualize::publishNode3DPoses(Node3D& node, const PlannerConfig& config)
 {
     geometry_msgs::Pose pose;
     pose.position.x = node.getX() * Constants::cellSize;
     pose.position.y = node.getY() * Constants::cellSize;
 
     // FORWARD
-    if (node.getPrim() < Node3D::forward_size_)
+    if (!config.isReverse(node.getPrim()))
     {
         pose.orientation = tf::createQuaternionMsgFromYaw(node.getT());
         poses3D.poses.push_back(pose);
@@ -127,7 +127,7 @@ void Visualize::publishNode2DPoses(Node2D& node)
 //###################################################
 //                                    COST HEATMAP 3D
 //###################################################
-void Visualize::publishNode3DCosts(Node3D* nodes, int width, int height, int depth)
+void Visualize::publishNode3DCosts(const Node3DStore& nodes, int width, int height)
 {
     visualization_msgs::MarkerArray costCubes;
     visualization_msgs::Marker      costCube;
@@ -144,26 +144,25 @@ void Visualize::publishNode3DCosts(Node3D* nodes, int width, int height, int dep
     ColorGradient heatMapGradient;
     heatMapGradient.createDefaultHeatMapGradient();
 
-    float values[width * height];
+    std::vector<float> values(width * height, 1000);
 
     // ________________________________
     // DETERMINE THE MAX AND MIN VALUES
-    for (int i = 0; i < width * height; ++i)
+    // iterate over all nodes the search has touched
+    for (int i = 0; i < nodes.size(); ++i)
     {
-        values[i] = 1000;
+        const SearchNode& node = nodes.node(i);
 
-        // iterate over all headings
-        for (int k = 0; k < depth; ++k)
+        // set the minimum for the cell
+        if (node.isClosed() || node.isOpen())
         {
-            idx = k * width * height + i;
-
-            // set the minimum for the cell
-            if (nodes[idx].isClosed() || nodes[idx].isOpen())
-            {
-                values[i] = nodes[idx].getC();
-            }
+            idx         = nodes.pose(i).idx % (width * height);
+            values[idx] = std::min(values[idx], node.getC());
         }
+    }
 
+    for (int i = 0; i < width * height; ++i)
+    {
         // set a new minimum
         if (values[i] > 0 && values[i] < min)
         {
@@ -230,7 +229,7 @@ void Visualize::publishNode3DCosts(Node3D* nodes, int width, int height, int dep
 //###################################################
 //                                    COST HEATMAP 2D
 //###################################################
-void Visualize::publishNode2DCosts(Node2D* nodes, int width, int height)
+void Visualize::publishNode2DCosts(const HolonomicHeuristic& holonomic, int width, int height)
 {
     visualization_msgs::MarkerArray costCubes;
     visualization_msgs::Marker      costCube;
@@ -246,7 +245,7 @@ void Visualize::publishNode2DCosts(Node2D* nodes, int width, int height)
     ColorGradient heatMapGradient;
     heatMapGradient.createDefaultHeatMapGradient();
 
-    float values[width * height];
+    std::vector<float> values(width * height);
 
     // ________________________________
     // DETERMINE THE MAX AND MIN VALUES
@@ -255,9 +254,9 @@ void Visualize::publishNode2DCosts(Node2D* nodes, int width, int height)
         values[i] = 1000;
 
         // set the minimum for the cell
-        if (nodes[i].isDiscovered())
+        if (holonomic.isReachable(i % width, i / width))
         {
-            values[i] = nodes[i].getG();
+            values[i] = holonomic.getCost(i % width, i / width);
 
             // set a new minimum
             if (values[i] > 0 && values[i] < min)
@@ -278,7 +277,7 @@ void Visualize::publishNode2DCosts(Node2D* nodes, int width, int height)
     for (int i = 0; i < width * height; ++i)
     {
         // if a value exists continue
-        if (nodes[i].isDiscovered())
+        if (values[i] != 1000)
         {
             count++;
 
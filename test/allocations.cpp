@@ -0,0 +1,132 @@
+/**
+   \file allocations.cpp
+   \brief Counts the heap allocations of the search once its buffers are warmed up, the expansions must not allocate
+*/
+
+#include <gtest/gtest.h>
+#include <ros/ros.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "scene.h"
+
+using namespace HybridAStar;
+
+//###################################################
+//                              COUNTING ALLOCATIONS
+//###################################################
+namespace
+{
+/// The number of allocations since the start of the program
+std::atomic<long> allocations(0);
+
+/// Allocates the memory and counts the allocation
+void* allocate(std::size_t size)
+{
+    allocations++;
+
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc();
+}
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    allocations++;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    allocations++;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+//###################################################
+//                                              TESTS
+//###################################################
+namespace
+{
+/// A query in cells
+struct Query
+{
+    float sx, sy, st, gx, gy, gt;
+};
+
+/// The queries on maps/map.pgm, forward, around obstacles and a short maneuver in reverse
+const Query queries[] = {{20, 205, 0, 280, 205, 0},
+                         {20, 40, 0, 120, 150, M_PI / 2},
+                         {150, 40, M_PI, 40, 200, M_PI / 2},
+                         {150, 205, 0, 140, 205, 0}};
+}  // namespace
+
+TEST(Allocations, SearchDoesNotAllocateOnceWarm)
+{
+    Scene scene("map.pgm");
+
+    // the first searches grow the buffers of the workspace, the heuristic and the collision detection
+    for (const Query& query : queries)
+    {
+        scene.plan(query.sx, query.sy, query.st, query.gx, query.gy, query.gt);
+    }
+
+    // clearing the visualization before a search publishes its markers, the search itself must not allocate
+    long before = allocations;
+    scene.visualization.clear();
+    long perSearch = allocations - before;
+
+    for (const Query& query : queries)
+    {
+        before        = allocations;
+        int  solution = scene.plan(query.sx, query.sy, query.st, query.gx, query.gy, query.gt);
+        long counted  = allocations - before;
+
+        EXPECT_EQ(perSearch, counted) << counted - perSearch << " allocations for " << scene.nodes()
+                                      << " stored nodes from (" << query.sx << ", " << query.sy << ") to ("
+                                      << query.gx << ", " << query.gy << ")"
+                                      << (scene.reachesGoal(solution) ? "" : " without reaching the goal");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    ros::init(argc, argv, "test_allocations");
+    return RUN_ALL_TESTS();
+}
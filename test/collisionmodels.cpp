@@ -0,0 +1,131 @@
+/**
+   \file collisionmodels.cpp
+   \brief Compares the disk model of CollisionDetection to the footprint on random configurations of every map in
+   maps/, the disk model must never free a configuration the footprint collides in
+*/
+
+#include <dirent.h>
+#include <gtest/gtest.h>
+#include <png.h>
+#include <ros/ros.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "scene.h"
+
+using namespace HybridAStar;
+
+namespace
+{
+/// The number of configurations sampled per map
+const int samples = 100000;
+
+/// Loads a PNG image into an occupancy grid, the brightness of a pixel is the mean of its channels
+nav_msgs::OccupancyGrid::Ptr loadPng(const std::string& path)
+{
+    png_image image = {};
+    image.version   = PNG_IMAGE_VERSION;
+
+    if (!png_image_begin_read_from_file(&image, path.c_str()))
+    {
+        throw std::runtime_error("the map " + path + " is not a PNG image");
+    }
+
+    image.format = PNG_FORMAT_RGB;
+    std::vector<unsigned char> rgb(PNG_IMAGE_SIZE(image));
+
+    if (!png_image_finish_read(&image, nullptr, rgb.data(), 0, nullptr))
+    {
+        png_image_free(&image);
+        throw std::runtime_error("the map " + path + " is truncated");
+    }
+
+    std::vector<unsigned char> pixels(image.width * image.height);
+
+    for (size_t i = 0; i < pixels.size(); ++i)
+    {
+        pixels[i] = (rgb[3 * i] + rgb[3 * i + 1] + rgb[3 * i + 2]) / 3;
+    }
+
+    return Scene::toGrid(image.width, image.height, pixels);
+}
+
+/// get the file names of the images in maps/
+std::vector<std::string> listMaps()
+{
+    std::vector<std::string> maps;
+
+    if (DIR* directory = opendir(HYBRID_ASTAR_MAPS))
+    {
+        while (dirent* entry = readdir(directory))
+        {
+            std::string name = entry->d_name;
+
+            if (name.size() > 4 && (name.substr(name.size() - 4) == ".pgm" || name.substr(name.size() - 4) == ".png"))
+            {
+                maps.push_back(name);
+            }
+        }
+
+        closedir(directory);
+    }
+
+    std::sort(maps.begin(), maps.end());
+    return maps;
+}
+}  // namespace
+
+TEST(CollisionModels, DisksMissNoCollisionOfTheFootprint)
+{
+    const std::vector<std::string> maps = listMaps();
+    ASSERT_FALSE(maps.empty()) << "no maps in " << HYBRID_ASTAR_MAPS;
+
+    for (const std::string& name : maps)
+    {
+        std::string                  path = std::string(HYBRID_ASTAR_MAPS) + "/" + name;
+        nav_msgs::OccupancyGrid::Ptr grid =
+            name.substr(name.size() - 4) == ".png" ? loadPng(path) : Scene::loadMap(path);
+        Scene scene(grid);
+
+        std::mt19937                          generator(0);
+        std::uniform_real_distribution<float> uniformX(0, grid->info.width);
+        std::uniform_real_distribution<float> uniformY(0, grid->info.height);
+        std::uniform_int_distribution<int>    uniformT(0, scene.config->headings - 1);
+        int                                   missed   = 0;
+        int                                   blocked  = 0;
+        int                                   disagree = 0;
+
+        for (int i = 0; i < samples; ++i)
+        {
+            float x = uniformX(generator);
+            float y = uniformY(generator);
+            float t = uniformT(generator) * scene.config->deltaHeadingRad;
+
+            bool exact = scene.configurationSpace.configurationTest(x, y, t);
+            bool disk  = scene.configurationSpace.diskTest(x, y, t);
+
+            blocked += !exact;
+
+            if (exact != disk)
+            {
+                disagree++;
+                missed += disk;
+            }
+        }
+
+        EXPECT_EQ(0, missed) << name << ": the disk model frees " << missed << " of " << blocked
+                             << " colliding configurations";
+        RecordProperty(name, std::to_string(disagree - missed) + " of " + std::to_string(samples - blocked) +
+                                 " free configurations blocked by the disks");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    ros::init(argc, argv, "test_collisionmodels");
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,193 @@
+/**
+   \file lookup.cpp
+   \brief Checks that the analytical lookup bounds the lengths of the analytical solutions from below, as the heuristic
+   has to, that the vector kernels of the heuristic look up the same entries and that its cache maps the lookup it wrote
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "heuristic.h"
+#include "holonomicheuristic.h"
+#include "lookup.h"
+#include "lookupcache.h"
+
+using namespace HybridAStar;
+
+//###################################################
+//                                              TESTS
+//###################################################
+namespace
+{
+/// The number of random relative poses
+const int samples = 200000;
+
+/// Builds the lookup once for all tests through a cache in the temporary directory
+class LookupTest : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        std::remove(path().c_str());
+        cache = new LookupCache();
+        cache->open(path());
+        cache->wait();
+    }
+
+    static void TearDownTestCase()
+    {
+        delete cache;
+        cache = nullptr;
+        std::remove(path().c_str());
+    }
+
+    /// the file of the cache
+    static std::string path()
+    {
+        return testing::TempDir() + "test_lookup.bin";
+    }
+
+    /// the cache built by the first test
+    static LookupCache* cache;
+};
+
+LookupCache* LookupTest::cache = nullptr;
+}  // namespace
+
+TEST_F(LookupTest, NeverExceedsTheAnalyticalLength)
+{
+    const float* lookup = cache->getDubinsLookup();
+    ASSERT_NE(nullptr, lookup);
+
+    std::mt19937                          generator(0);
+    std::uniform_real_distribution<float> uniformP(-Constants::dubinsWidth, Constants::dubinsWidth);
+    std::uniform_real_distribution<float> uniformT(-M_PI, M_PI);
+    int                                   inside   = 0;
+    int                                   exceeded = 0;
+    float                                 worst    = 0;
+
+    for (int i = 0; i < samples; ++i)
+    {
+        float x   = uniformP(generator);
+        float y   = uniformP(generator);
+        float t   = uniformT(generator);
+        int   idx = Lookup::dubinsLookupIndex(x, y, t);
+
+        if (idx < 0)
+        {
+            continue;
+        }
+
+        // the lengths are computed in single precision
+        float length = Lookup::analyticalLength(x, y, t);
+        inside++;
+
+        if (lookup[idx] > length * (1 + 1e-5f))
+        {
+            exceeded++;
+            worst = std::max(worst, lookup[idx] - length);
+        }
+    }
+
+    EXPECT_GT(inside, samples / 2);
+    EXPECT_EQ(0, exceeded) << "the lookup exceeds " << exceeded << " of " << inside << " analytical lengths by up to "
+                           << worst;
+}
+
+TEST_F(LookupTest, BatchesLookUpTheEntriesOfTheIndex)
+{
+    // a free grid, the holonomic term stays below the offset of the entries
+    const int                    size   = 2 * Constants::dubinsWidth + 4;
+    const float                  offset = 1000;
+    nav_msgs::OccupancyGrid::Ptr grid(new nav_msgs::OccupancyGrid);
+    grid->info.width      = size;
+    grid->info.height     = size;
+    grid->info.resolution = Constants::cellSize;
+    grid->data.assign(size * size, 0);
+    HolonomicHeuristic holonomic;
+    holonomic.setMap(grid);
+    holonomic.setGoal(size / 2, size / 2);
+
+    // every entry holds its index, so that the cost-to-go tells the entry a lane looked up
+    std::vector<float> marked(Constants::dubinsLookupSize);
+
+    for (int idx = 0; idx < Constants::dubinsLookupSize; ++idx)
+    {
+        marked[idx] = idx + offset;
+    }
+
+    // a pose whose rounding the kernels may resolve differently by the last bit is not compared
+    auto ambiguous = [](float value) {
+        float fraction = value - std::floor(value);
+        return fraction < 1e-3f || fraction > 1 - 1e-3f;
+    };
+
+    std::mt19937                          generator(0);
+    std::uniform_real_distribution<float> uniformP(2, size - 2);
+    std::uniform_real_distribution<float> uniformT(0, 2 * M_PI);
+    const Node3D                          goal(size / 2 + 0.5f, size / 2 + 0.5f, 1, 0, 0);
+    HeuristicBatch                        batch;
+    int                                   compared = 0;
+    int                                   differ   = 0;
+
+    for (int i = 0; i < samples / HeuristicBatch::capacity; ++i)
+    {
+        batch.clear();
+
+        while (batch.size < HeuristicBatch::capacity)
+        {
+            batch.push(Node3D(uniformP(generator), uniformP(generator), uniformT(generator), 0, 0));
+        }
+
+        Heuristic::evaluate(batch, goal, holonomic, marked.data());
+
+        for (int j = 0; j < batch.size; ++j)
+        {
+            // the pose of the goal relative to the lane as the scalar kernel computes it
+            float dx  = goal.getX() - batch.x[j];
+            float dy  = goal.getY() - batch.y[j];
+            float x   = std::cos(batch.t[j]) * dx + std::sin(batch.t[j]) * dy;
+            float y   = -std::sin(batch.t[j]) * dx + std::cos(batch.t[j]) * dy;
+            float t   = goal.getT() - batch.t[j];
+            int   idx = Lookup::dubinsLookupIndex(x, y, t);
+            float h   = std::fmod(std::abs(t), 2 * (float)M_PI) / Constants::deltaHeadingRad + 0.5f;
+
+            if (idx < 0 || ambiguous(std::abs(x) * Constants::positionResolution + 0.5f) ||
+                ambiguous(std::abs(y) * Constants::positionResolution + 0.5f) || ambiguous(h) ||
+                ambiguous(Constants::headings - h + 1))
+            {
+                continue;
+            }
+
+            compared++;
+            differ += batch.h[j] != marked[idx];
+        }
+    }
+
+    EXPECT_GT(compared, samples / 4);
+    EXPECT_EQ(0, differ) << "the kernels look up other entries than the index for " << differ << " of " << compared
+                         << " poses";
+}
+
+TEST_F(LookupTest, CacheMapsTheLookupItWrote)
+{
+    LookupCache mapped;
+    mapped.open(path());
+
+    // mapped at once, without a build in the background
+    const float* lookup = mapped.getDubinsLookup();
+    ASSERT_NE(nullptr, lookup);
+    EXPECT_EQ(0, std::memcmp(cache->getDubinsLookup(), lookup, Constants::dubinsLookupSize * sizeof(float)));
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,228 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <nav_msgs/OccupancyGrid.h>
+
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "algorithm.h"
+#include "collisiondetection.h"
+#include "dynamicvoronoi.h"
+#include "helper.h"
+#include "holonomicheuristic.h"
+#include "lookupcache.h"
+#include "node3d.h"
+#include "plannerconfig.h"
+#include "searchworkspace.h"
+#include "visualize.h"
+
+/// The directory of the maps, set by the build
+#ifndef HYBRID_ASTAR_MAPS
+#define HYBRID_ASTAR_MAPS "maps"
+#endif
+
+namespace HybridAStar
+{
+/*!
+   \brief A map of maps/ and everything the search needs to plan on it, shared by the tests and the benchmarks.
+
+   It prepares the map the way Planner::setMap() does, without subscribing to topics or smoothing the path.
+*/
+class Scene
+{
+public:
+    /*!
+       \brief Loads the map and prepares the configuration space
+       \param file the file name of a PGM map in maps/
+       \param config the configuration of the planner
+    */
+    explicit Scene(const std::string& file,
+                   std::shared_ptr<const PlannerConfig> config = std::make_shared<const PlannerConfig>())
+        : Scene(loadMap(std::string(HYBRID_ASTAR_MAPS) + "/" + file), config)
+    {
+    }
+
+    /*!
+       \brief Prepares the configuration space of the map
+       \param grid the map
+       \param config the configuration of the planner
+    */
+    explicit Scene(const nav_msgs::OccupancyGrid::Ptr& grid,
+                   std::shared_ptr<const PlannerConfig> config = std::make_shared<const PlannerConfig>())
+        : grid(grid), config(config)
+    {
+        int width  = grid->info.width;
+        int height = grid->info.height;
+        // the binary map is owned by the Voronoi diagram
+        bool** binMap = new bool*[width];
+
+        for (int x = 0; x < width; ++x)
+        {
+            binMap[x] = new bool[height];
+
+            for (int y = 0; y < height; ++y)
+            {
+                binMap[x][y] = grid->data[y * width + x] ? true : false;
+            }
+        }
+
+        holonomic.setMap(grid);
+        configurationSpace.updateGrid(grid);
+        configurationSpace.updateHeadings(config->headings);
+        configurationSpace.updatePrimitives(config->deltaX, config->deltaY, config->deltaT);
+        voronoiDiagram.initializeMap(width, height, binMap);
+        voronoiDiagram.update();
+        configurationSpace.updateDistances(voronoiDiagram);
+
+        // the planner's cache of the lookup, mapped if a previous run wrote it
+        lookups.open(Constants::lookupCache);
+        lookups.wait();
+    }
+
+    /*!
+       \brief Searches a path from the start to the goal pose given in cells
+       \param trace if not a nullptr the operations on the open list are recorded on it
+       \return the position of the node satisfying the goal condition in the store or -1
+    */
+    int plan(float sx, float sy, float st, float gx, float gy, float gt, OpenListTrace* trace = nullptr)
+    {
+        workspace.prepare();
+        visualization.clear();
+        goal = Node3D(gx, gy, Helper::normalizeHeadingRad(gt), 0, 0);
+        Node3D start(sx, sy, Helper::normalizeHeadingRad(st), 0, 0);
+        holonomic.setGoal((int)gx, (int)gy);
+        return Algorithm::hybridAStar(start, goal, workspace, holonomic, grid->info.width, grid->info.height,
+                                      configurationSpace, lookups.getDubinsLookup(), *config, visualization, trace);
+    }
+
+    /// Determines whether the position returned by plan() satisfies the goal condition, not the limit of iterations
+    bool reachesGoal(int solution) const
+    {
+        return solution >= 0 && workspace.nodes3D.get(solution).isSimilar(goal, config->deltaHeadingRad);
+    }
+
+    /*!
+       \brief Measures the path of the last search
+       \param solution the position returned by plan()
+       \return the length of the path in cells or -1 if it does not reach the goal
+    */
+    float pathLength(int solution) const
+    {
+        if (!reachesGoal(solution))
+        {
+            return -1;
+        }
+
+        float length = 0;
+
+        for (uint32_t i = solution; workspace.nodes3D.node(i).getPred() != SearchNode::none;
+             i = workspace.nodes3D.node(i).getPred())
+        {
+            const Node3DStore::Pose& pose = workspace.nodes3D.pose(i);
+            const Node3DStore::Pose& pred = workspace.nodes3D.pose(workspace.nodes3D.node(i).getPred());
+            length += std::hypot(pose.x - pred.x, pose.y - pred.y);
+        }
+
+        return length;
+    }
+
+    /// get the number of nodes the last search stored, an upper bound of the nodes it expanded
+    int nodes() const
+    {
+        return workspace.nodes3D.size();
+    }
+
+    /*!
+       \brief Loads a binary PGM (P5) image into an occupancy grid, see toGrid()
+       \param path the path of the image
+       \return the grid, it throws std::runtime_error if the image can not be read
+    */
+    static nav_msgs::OccupancyGrid::Ptr loadMap(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string   magic;
+        int           width = 0, height = 0, maxValue = 0;
+        in >> magic;
+
+        // skip the comments of the header
+        while (in >> std::ws && in.peek() == '#')
+        {
+            in.ignore(1 << 16, '\n');
+        }
+
+        in >> width >> height >> maxValue;
+        in.get();
+
+        if (!in || magic != "P5" || width <= 0 || height <= 0 || maxValue != 255)
+        {
+            throw std::runtime_error("the map " + path + " is not a binary PGM image");
+        }
+
+        std::vector<unsigned char> pixels(width * height);
+        in.read(reinterpret_cast<char*>(pixels.data()), pixels.size());
+
+        if (!in)
+        {
+            throw std::runtime_error("the map " + path + " is truncated");
+        }
+
+        return toGrid(width, height, pixels);
+    }
+
+    /*!
+       \brief Converts an image into an occupancy grid with one cell per pixel, like the map_server with the free_thresh
+       of maps/map.yaml, bright pixels are free, all others occupied
+       \param width the width of the image
+       \param height the height of the image
+       \param pixels the brightness of the pixels row by row, the first row is the top of the map
+       \return the grid
+    */
+    static nav_msgs::OccupancyGrid::Ptr toGrid(int width, int height, const std::vector<unsigned char>& pixels)
+    {
+        nav_msgs::OccupancyGrid::Ptr map(new nav_msgs::OccupancyGrid);
+        map->info.width      = width;
+        map->info.height     = height;
+        map->info.resolution = Constants::cellSize;
+        map->data.resize(width * height);
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                float occupancy = (255 - pixels[(height - 1 - y) * width + x]) / 255.f;
+                map->data[y * width + x] = occupancy < freeThreshold ? 0 : 100;
+            }
+        }
+
+        return map;
+    }
+
+    /// the free_thresh of maps/map.yaml
+    static constexpr float freeThreshold = 0.05f;
+
+    /// the map
+    nav_msgs::OccupancyGrid::Ptr grid;
+    /// the configuration of the planner
+    std::shared_ptr<const PlannerConfig> config;
+    /// the goal of the last search
+    Node3D goal;
+    /// the collision detection
+    CollisionDetection configurationSpace;
+    /// the Voronoi diagram
+    DynamicVoronoi voronoiDiagram;
+    /// the holonomic with obstacles heuristic
+    HolonomicHeuristic holonomic;
+    /// the lookup of analytical solutions if Constants::dubinsLookup is set
+    LookupCache lookups;
+    /// the buffers of the search
+    SearchWorkspace workspace;
+    /// the visualization collecting the expanded nodes
+    Visualize visualization;
+};
+}  // namespace HybridAStar
+#endif  // SCENE_H